@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    DelayCrossfade.cpp
+    Created: 19 Oct 2026 9:14:32am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "DelayCrossfade.h"
+
+void DelayCrossfade::prepareToPlay(double sampleRate) {
+  int newLength =
+      juce::jmax(1, int(std::round(fadeLengthInSeconds * sampleRate)));
+
+  // Table only depends on the length, keep it across re-preparation
+  if (newLength != length) {
+    length = newLength;
+    fillEqualPowerTable(table, length);
+  }
+
+  reset();
+}
+
+void DelayCrossfade::fillEqualPowerTable(std::vector<float> &table,
+                                         int length) {
+  table.resize(size_t(length) + 1);
+
+  float halfPi = juce::MathConstants<float>::halfPi;
+  for (int i = 0; i <= length; ++i)
+    table[size_t(i)] = std::sin(halfPi * float(i) / float(length));
+}
+
+void DelayCrossfade::reset() noexcept {
+  // Position at the end of the table means no fade is running
+  position = length;
+
+  currentDelay = 0.0f;
+  nextDelay = 0.0f;
+}
+
+bool DelayCrossfade::start(float newDelayInSamples) noexcept {
+  if (currentDelay == 0.0f) {
+    currentDelay = newDelayInSamples;
+    nextDelay = newDelayInSamples;
+    return false;
+  }
+
+  nextDelay = newDelayInSamples;
+  position = 0;
+  return true;
+}
+
+void DelayCrossfade::setCurrentDelay(float delayInSamples) noexcept {
+  position = length;
+
+  currentDelay = delayInSamples;
+  nextDelay = delayInSamples;
+}
+
+void DelayCrossfade::nextGains(float &fadeOut, float &fadeIn) noexcept {
+  fadeIn = table[size_t(position)];
+  fadeOut = table[size_t(length - position)];
+
+  ++position;
+
+  // Once the fade completes the incoming head becomes the only head
+  if (position == length)
+    currentDelay = nextDelay;
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    DelayCrossfade.h
+    Created: 19 Oct 2026 9:14:32am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Two read heads on the same delay line for jumping the delay time without
+ pitch glide. While idle only the current head is read. On a change the new
+ head fades in while the old one fades out over a fixed number of samples,
+ with gains coming from a precomputed equal-power (sin/cos) table.
+*/
+class DelayCrossfade {
+public:
+  DelayCrossfade() = default;
+
+  void prepareToPlay(double sampleRate);
+  void reset() noexcept;
+
+  // Returns true if a fade was started towards the new delay time. The very
+  // first delay after reset() is taken as is, since there is nothing to fade
+  // out from yet.
+  bool start(float newDelayInSamples) noexcept;
+
+  // Stops any fade and reads at delayInSamples, for taking over from a
+  // delay line that was gliding
+  void setCurrentDelay(float delayInSamples) noexcept;
+
+  // Advances the fade by one sample and returns the gains for the current
+  // (outgoing) and next (incoming) read heads.
+  void nextGains(float &fadeOut, float &fadeIn) noexcept;
+
+  bool isFading() const noexcept { return position < length; }
+
+  float getCurrentDelay() const noexcept { return currentDelay; }
+  float getNextDelay() const noexcept { return nextDelay; }
+
+  // Fills table with sin(0 .. pi/2) over length + 1 points, shared with
+  // the other places that need an equal-power fade
+  static void fillEqualPowerTable(std::vector<float> &table, int length);
+
+  // 50 ms is long enough to hide the splice and short enough to still feel
+  // like an instant change when turning the knob.
+  static constexpr double fadeLengthInSeconds = 0.05;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayCrossfade)
+
+  // sin(0 .. pi/2) sampled over length + 1 points. The fade out gain is the
+  // same table read backwards, i.e. cos.
+  std::vector<float> table;
+
+  int length = 0;
+  int position = 0;
+
+  float currentDelay = 0.0f;
+  float nextDelay = 0.0f;
+};
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    DelayMemoryPool.cpp
+    Created: 19 Oct 2026 1:37:50pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "DelayMemoryPool.h"
+
+#if JUCE_LINUX || JUCE_ANDROID
+#include <sys/mman.h>
+#endif
+
+static size_t roundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+/*
+ On Linux the slab is mapped straight from the kernel, asking for huge
+ pages first. Explicit huge pages are often not reserved on desktop
+ systems, so the fallback is a normal mapping with a transparent huge
+ page hint. Elsewhere it is a plain cache-line aligned allocation.
+*/
+static float *allocatePages(size_t &bytes, bool &hugePages) {
+  hugePages = false;
+
+#if JUCE_LINUX || JUCE_ANDROID
+  constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+#ifdef MAP_HUGETLB
+  size_t hugeBytes = roundUp(bytes, hugePageSize);
+  void *huge = mmap(nullptr, hugeBytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (huge != MAP_FAILED) {
+    bytes = hugeBytes;
+    hugePages = true;
+    return static_cast<float *>(huge);
+  }
+#endif
+
+  bytes = roundUp(bytes, size_t(juce::SystemStats::getPageSize()));
+  void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    return nullptr;
+
+#ifdef MADV_HUGEPAGE
+  if (bytes >= hugePageSize)
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+
+  return static_cast<float *>(ptr);
+#else
+  bytes = roundUp(bytes, DelayMemoryPool::cacheLineSize);
+  return static_cast<float *>(::operator new(
+      bytes, std::align_val_t(DelayMemoryPool::cacheLineSize), std::nothrow));
+#endif
+}
+
+void DelayMemoryPool::freeSlab(Slab &slab) noexcept {
+#if JUCE_LINUX || JUCE_ANDROID
+  munmap(slab.data, slab.bytes);
+#else
+  ::operator delete(slab.data, std::align_val_t(cacheLineSize));
+#endif
+  slab.data = nullptr;
+}
+
+DelayMemoryPool::~DelayMemoryPool() {
+  // Every instance should have handed its memory back by now
+  for (auto &slab : slabs) {
+    jassert(!slab.inUse);
+    freeSlab(slab);
+  }
+}
+
+float *DelayMemoryPool::acquire(double sampleRate, int numChannels,
+                                int channelSize, int &channelStride) {
+  // Round each channel up to whole cache lines so all of them stay aligned
+  constexpr int floatsPerLine = cacheLineSize / int(sizeof(float));
+  channelStride = int(roundUp(size_t(channelSize), floatsPerLine));
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  for (auto &slab : slabs) {
+    if (!slab.inUse && slab.sampleRate == sampleRate &&
+        slab.numChannels == numChannels && slab.channelSize == channelSize) {
+      // Not cleared, the delay line ignores old contents until overwritten
+      slab.inUse = true;
+      ++reused;
+      return slab.data;
+    }
+  }
+
+  Slab slab;
+  slab.sampleRate = sampleRate;
+  slab.numChannels = numChannels;
+  slab.channelSize = channelSize;
+  slab.bytes = size_t(channelStride) * size_t(numChannels) * sizeof(float);
+  slab.data = allocatePages(slab.bytes, slab.hugePages);
+  slab.inUse = true;
+
+  if (slab.data == nullptr)
+    return nullptr;
+
+  slabs.push_back(slab);
+  ++allocated;
+  return slab.data;
+}
+
+void DelayMemoryPool::release(float *data) noexcept {
+  if (data == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  for (auto it = slabs.begin(); it != slabs.end(); ++it) {
+    if (it->data == data) {
+      jassert(it->inUse);
+      it->inUse = false;
+
+      if (!enabled) {
+        freeSlab(*it);
+        slabs.erase(it);
+      }
+      return;
+    }
+  }
+
+  // Memory that did not come from this pool
+  jassertfalse;
+}
+
+void DelayMemoryPool::trim() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  for (auto &slab : slabs)
+    if (!slab.inUse)
+      freeSlab(slab);
+
+  slabs.erase(std::remove_if(slabs.begin(), slabs.end(),
+                             [](const Slab &s) { return s.data == nullptr; }),
+              slabs.end());
+}
+
+void DelayMemoryPool::setEnabled(bool shouldBeEnabled) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    enabled = shouldBeEnabled;
+  }
+
+  if (!shouldBeEnabled)
+    trim();
+}
+
+bool DelayMemoryPool::isEnabled() const {
+  std::lock_guard<std::mutex> guard(lock);
+  return enabled;
+}
+
+DelayMemoryPool::Stats DelayMemoryPool::getStats() const {
+  std::lock_guard<std::mutex> guard(lock);
+
+  Stats stats;
+  for (const auto &slab : slabs) {
+    if (slab.inUse) {
+      ++stats.slabsInUse;
+      stats.bytesInUse += slab.bytes;
+    } else {
+      ++stats.slabsIdle;
+      stats.bytesIdle += slab.bytes;
+    }
+
+    if (slab.hugePages)
+      ++stats.hugePageSlabs;
+  }
+
+  stats.reused = reused;
+  stats.allocated = allocated;
+  return stats;
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    DelayMemoryPool.h
+    Created: 19 Oct 2026 1:37:50pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Process-wide store of delay buffer memory shared by all plug-in instances.
+
+ Instances take a slab when they are prepared and hand it back in
+ releaseResources. Returned slabs are kept around and given to the next
+ instance asking for the same sample rate and size, so reloading a session
+ with many instances does not hit the system allocator for every one.
+
+ Access it through juce::SharedResourcePointer<DelayMemoryPool>, the pool
+ (and any idle memory) goes away with the last instance holding it.
+*/
+class DelayMemoryPool {
+public:
+  DelayMemoryPool() = default;
+  ~DelayMemoryPool();
+
+  struct Stats {
+    int slabsInUse = 0;
+    int slabsIdle = 0;
+    size_t bytesInUse = 0;
+    size_t bytesIdle = 0;
+    int hugePageSlabs = 0;
+
+    // Number of acquire() calls served from an idle slab vs. a new one
+    int reused = 0;
+    int allocated = 0;
+  };
+
+  // Returns memory for numChannels channels of channelSize samples each.
+  // Every channel starts on a cache line, channelStride gives the distance
+  // between channels in samples. A reused slab is not cleared, it still
+  // holds whatever the previous owner left in it.
+  float *acquire(double sampleRate, int numChannels, int channelSize,
+                 int &channelStride);
+
+  void release(float *data) noexcept;
+
+  // Frees all idle slabs
+  void trim();
+
+  // When disabled, released slabs are freed straight away instead of being
+  // kept for other instances
+  void setEnabled(bool shouldBeEnabled);
+  bool isEnabled() const;
+
+  Stats getStats() const;
+
+  static constexpr int cacheLineSize = 64;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayMemoryPool)
+
+  struct Slab {
+    double sampleRate;
+    int numChannels;
+    int channelSize;
+
+    float *data;
+    size_t bytes;
+    bool hugePages;
+    bool inUse;
+  };
+
+  static void freeSlab(Slab &slab) noexcept;
+
+  mutable std::mutex lock;
+  std::vector<Slab> slabs;
+
+  bool enabled = true;
+  int reused = 0;
+  int allocated = 0;
+};
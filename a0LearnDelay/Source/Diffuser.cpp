@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    Diffuser.cpp
+    Created: 19 Oct 2026 9:53:20pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "Diffuser.h"
+
+/*
+ Stage delays in milliseconds. Mutually prime-ish so the echoes of the
+ stages do not line up, the right channel is stretched slightly for a
+ wider image. About 28 ms in total.
+*/
+static constexpr std::array<float, Diffuser::numStages> stageTimes{
+    4.77f, 3.59f, 12.73f, 9.30f, 1.91f, 6.13f};
+static constexpr float rightChannelStretch = 1.07f;
+
+// Allpass gain at full diffusion, above this the chain starts to ring
+static constexpr float maxAllpassGain = 0.7f;
+
+Diffuser::~Diffuser() { releaseMemory(); }
+
+void Diffuser::prepareToPlay(double sampleRate, int maximumBlockSize) {
+  input.setSize(numChannels, maximumBlockSize, false, false, true);
+
+  if (sampleRate != preparedSampleRate || memory == nullptr) {
+    releaseMemory();
+    preparedSampleRate = sampleRate;
+
+    // Lay out the rings of one channel, each on a cache line boundary
+    constexpr int floatsPerLine =
+        DelayMemoryPool::cacheLineSize / int(sizeof(float));
+    int channelSize = 0;
+    for (int channel = 0; channel < numChannels; ++channel) {
+      int offset = 0;
+      float stretch = channel == 0 ? 1.0f : rightChannelStretch;
+
+      for (int i = 0; i < numStages; ++i) {
+        auto &stage = stages[size_t(channel)][size_t(i)];
+        float delay = stageTimes[size_t(i)] * stretch * 0.001f;
+
+        stage.delay = juce::jmax(1, int(delay * float(sampleRate)));
+        int size = juce::nextPowerOfTwo(stage.delay + 1);
+        stage.mask = size - 1;
+        stage.offset = offset;
+
+        offset += juce::jmax(size, floatsPerLine);
+      }
+
+      channelSize = juce::jmax(channelSize, offset);
+    }
+
+    memory = pool->acquire(sampleRate, numChannels, channelSize, channelStride);
+
+    // Out of memory, thrown like the delay line does
+    if (memory == nullptr)
+      throw std::bad_alloc();
+  }
+
+  reset();
+}
+
+void Diffuser::releaseMemory() noexcept {
+  pool->release(memory);
+  memory = nullptr;
+}
+
+void Diffuser::reset() noexcept {
+  positions.fill(0);
+  lastAmount = 0.0f;
+
+  // The rings are tiny, clearing them right away is cheap
+  if (memory != nullptr)
+    std::fill(memory, memory + size_t(channelStride) * numChannels, 0.0f);
+}
+
+void Diffuser::process(juce::AudioBuffer<float> &buffer, int numSamples,
+                       float amount) noexcept {
+  if (amount == 0.0f && lastAmount == 0.0f)
+    return;
+
+  float g = maxAllpassGain * amount;
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    float *data = buffer.getWritePointer(channel);
+    const float *dry = input.getReadPointer(channel);
+
+    input.copyFrom(channel, 0, data, numSamples);
+    processChannel(channel, data, numSamples, g);
+
+    // Blend between input and diffused signal, ramped across the block
+    // so amount changes do not step
+    float step = (amount - lastAmount) / float(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+      float blend = lastAmount + step * float(i + 1);
+      data[i] = dry[i] + blend * (data[i] - dry[i]);
+    }
+  }
+
+  lastAmount = amount;
+
+  // Fully off again, start from silence next time it is turned up
+  if (amount == 0.0f)
+    reset();
+}
+
+void Diffuser::processChannel(int channel, float *data, int numSamples,
+                              float g) noexcept {
+  float *block = memory + size_t(channel) * size_t(channelStride);
+  int start = positions[size_t(channel)];
+
+  for (const auto &stage : stages[size_t(channel)]) {
+    float *ring = block + stage.offset;
+    int position = start;
+
+    /*
+     Schroeder allpass with a single delay line
+        v[n] = x[n] + g * v[n - D]
+        y[n] = v[n - D] - g * v[n]
+    */
+    for (int i = 0; i < numSamples; ++i) {
+      float delayed = ring[(position - stage.delay) & stage.mask];
+      float v = data[i] + g * delayed;
+      ring[position & stage.mask] = v;
+      data[i] = delayed - g * v;
+      ++position;
+    }
+  }
+
+  // Masked per stage, so the counter may run on freely
+  positions[size_t(channel)] = (start + numSamples) & 0x3fffffff;
+}
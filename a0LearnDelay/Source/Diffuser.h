@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    Diffuser.h
+    Created: 19 Oct 2026 9:53:20pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayMemoryPool.h"
+#include <JuceHeader.h>
+
+/*
+ Chain of Schroeder allpass filters that smears the echoes into a
+ reverb-like wash.
+
+ Every stage keeps its history in a small power-of-two ring buffer, so
+ wrapping is a mask instead of a compare. All rings of one channel sit
+ back to back in a single cache-aligned block taken from the
+ DelayMemoryPool. Processing goes stage by stage over the whole block
+ rather than sample by sample through the whole chain.
+*/
+class Diffuser {
+public:
+  Diffuser() = default;
+  ~Diffuser();
+
+  // Throws std::bad_alloc when the pool has no memory for the rings
+  void prepareToPlay(double sampleRate, int maximumBlockSize);
+  void releaseMemory() noexcept;
+  void reset() noexcept;
+
+  // amount goes from 0 (bypassed) to 1, processes the buffer in place
+  void process(juce::AudioBuffer<float> &buffer, int numSamples,
+               float amount) noexcept;
+
+  static constexpr int numStages = 6;
+  static constexpr int numChannels = 2;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Diffuser)
+
+  struct Stage {
+    int offset;
+    int mask;
+    int delay;
+  };
+
+  void processChannel(int channel, float *data, int numSamples,
+                      float g) noexcept;
+
+  juce::SharedResourcePointer<DelayMemoryPool> pool;
+  float *memory = nullptr;
+  int channelStride = 0;
+
+  std::array<std::array<Stage, numStages>, numChannels> stages;
+
+  // Write position shared by all stages of a channel, wrapped per stage
+  std::array<int, numChannels> positions{};
+
+  // Input copy for blending between the dry and the diffused signal
+  juce::AudioBuffer<float> input;
+
+  double preparedSampleRate = 0.0;
+  float lastAmount = 0.0f;
+};
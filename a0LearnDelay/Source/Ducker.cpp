@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    Ducker.cpp
+    Created: 19 Oct 2026 11:02:17am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "Ducker.h"
+
+void Ducker::prepareToPlay(double sampleRate, int maximumBlockSize) {
+  // Never shrinks, a smaller block size keeps using the existing buffer
+  if (size_t(maximumBlockSize) > gains.size())
+    gains.resize(size_t(maximumBlockSize));
+
+  if (sampleRate != preparedSampleRate) {
+    preparedSampleRate = sampleRate;
+
+    // Same one-pole formula as the delay time smoothing, but the envelope
+    // is only updated once every sub-block
+    float subBlockRate = float(sampleRate) / float(subBlockSize);
+    attackCoeff = 1.0f - std::exp(-1.0f / (attackTime * subBlockRate));
+    releaseCoeff = 1.0f - std::exp(-1.0f / (releaseTime * subBlockRate));
+  }
+
+  reset();
+}
+
+void Ducker::reset() noexcept {
+  envelope = 0.0f;
+  gain = 1.0f;
+  smoothedAmount = 0.0f;
+}
+
+void Ducker::process(const juce::AudioBuffer<float> &key, int numSamples,
+                     float threshold, float amount) noexcept {
+  jassert(numSamples <= int(gains.size()));
+
+  int numChannels = key.getNumChannels();
+
+  for (int start = 0; start < numSamples; start += subBlockSize) {
+    int length = juce::jmin(subBlockSize, numSamples - start);
+
+    float peak = 0.0f;
+    for (int channel = 0; channel < numChannels; ++channel)
+      peak = juce::jmax(peak, key.getMagnitude(channel, start, length));
+
+    float coeff = peak > envelope ? attackCoeff : releaseCoeff;
+    envelope += (peak - envelope) * coeff;
+
+    smoothedAmount += (amount - smoothedAmount) * releaseCoeff;
+    if (std::abs(amount - smoothedAmount) < 0.001f)
+      smoothedAmount = amount;
+
+    /*
+     Gain reduction starts at the threshold and reaches the full amount
+     once the envelope is twice the threshold (6 dB above it).
+    */
+    float over = juce::jlimit(0.0f, 1.0f, (envelope - threshold) / threshold);
+    float target = 1.0f - smoothedAmount * over;
+
+    // Linear ramp to avoid steps in the gain at sub-block boundaries
+    float *dest = gains.data() + start;
+    float step = (target - gain) / float(length);
+    for (int i = 0; i < length; ++i)
+      dest[i] = gain + step * float(i + 1);
+
+    gain = target;
+  }
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    Ducker.h
+    Created: 19 Oct 2026 11:02:17am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Envelope follower that turns down the wet signal while a key signal (the
+ dry input or the sidechain bus) is loud.
+
+ Work is done per sub-block instead of per sample:
+    1) Peak of the key signal over each sub-block
+    2) Attack/release smoothing of those peaks
+    3) Gain target per sub-block, ramped linearly across the sub-block
+
+ The result is a gain per sample for the whole block which processBlock
+ multiplies into the wet signal.
+*/
+class Ducker {
+public:
+  Ducker() = default;
+
+  void prepareToPlay(double sampleRate, int maximumBlockSize);
+  void reset() noexcept;
+
+  // threshold is a linear gain, amount goes from 0 (no ducking) to 1
+  void process(const juce::AudioBuffer<float> &key, int numSamples,
+               float threshold, float amount) noexcept;
+
+  const float *getGains() const noexcept { return gains.data(); }
+
+  // Still turning the signal down or on its way back up to unity. Only
+  // once this is false can process stop being called without a step.
+  bool isDucking() const noexcept {
+    return gain < 1.0f || smoothedAmount > 0.0f;
+  }
+
+  static constexpr int subBlockSize = 32;
+
+  static constexpr float attackTime = 0.005f;
+  static constexpr float releaseTime = 0.2f;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Ducker)
+
+  std::vector<float> gains;
+
+  float envelope = 0.0f;
+  float gain = 1.0f;
+
+  // Amount follows the parameter at the release rate, so turning it down,
+  // or off, lets the gain come back up like a release does
+  float smoothedAmount = 0.0f;
+
+  // One-pole coefficients running at the sub-block rate
+  double preparedSampleRate = 0.0;
+  float attackCoeff = 0.0f;
+  float releaseCoeff = 0.0f;
+};
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 19 Oct 2026 4:48:03pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <bit>
+
+/*
+ Approximations for the conversions the DSP code does while processing:
+ exp2/log2, decibels <-> gain and tanh.
+
+ Each function comes in three forms: scalar, a four-lane SIMD version
+ (SSE2 or AArch64 NEON) and a block version for whole buffers that uses
+ the SIMD one where available. Use the scalar versions for one value per
+ block and the block versions for per-sample buffers.
+
+ Measured maximum errors against double precision, the same for the
+ scalar and SIMD versions:
+    exp2       : relative 2.5e-7 for x in [-126, 126]
+    log2       : absolute 4e-6 for x in [1e-30, 1e30], about one float
+                 step of the result at the ends of the range
+    dbToGain   : relative 9e-7 for -100 to +40 dB
+    gainToDb   : absolute 1.1e-5 dB for gains 1e-5 to 100
+    tanh       : absolute 2e-7 for any x
+
+ Tests/FastMathTests.cpp checks these bounds and that the SIMD results
+ match the scalar ones. Tests/FastMathBenchmarks.cpp times all three forms
+ against the library functions: with SSE2 the block dbToGain runs about
+ 5x faster than juce::Decibels::decibelsToGain and the block tanh about
+ 10x faster than std::tanh. The scalar exp2 is no faster than std::exp2,
+ the gain is in the SIMD and block versions.
+
+ Not a replacement everywhere, e.g. the one-pole coefficients are
+ 1 - exp(-small) and lose all precision with a relative error in exp.
+ Keep std::exp for those, they are only computed in prepareToPlay.
+*/
+namespace FastMath {
+
+// Same floor as JUCE Decibels, anything below is reported as this
+constexpr float minusInfinityDb = -100.0f;
+
+inline float exp2(float x) noexcept {
+  x = juce::jlimit(-126.0f, 126.0f, x);
+
+  // Split into integer and fractional part, fraction in [-0.5, 0.5]
+  float rounded = x + 0.5f;
+  int n = int(rounded);
+  n -= rounded < float(n) ? 1 : 0;
+  float f = x - float(n);
+
+  // Taylor series of e^(f * ln2) up to the 6th power
+  constexpr float c1 = 0.693147181f;
+  constexpr float c2 = 0.240226507f;
+  constexpr float c3 = 0.0555041087f;
+  constexpr float c4 = 0.00961812911f;
+  constexpr float c5 = 0.00133335581f;
+  constexpr float c6 = 0.000154035304f;
+  float p =
+      1.0f + f * (c1 + f * (c2 + f * (c3 + f * (c4 + f * (c5 + f * c6)))));
+
+  // 2^n built directly in the exponent bits
+  float scale = std::bit_cast<float>((n + 127) << 23);
+  return p * scale;
+}
+
+inline float log2(float x) noexcept {
+  auto bits = std::bit_cast<juce::int32>(x);
+  int exponent = ((bits >> 23) & 0xff) - 127;
+  float mantissa = std::bit_cast<float>((bits & 0x007fffff) | 0x3f800000);
+
+  // Move the mantissa into [sqrt(0.5), sqrt(2)) so the series below
+  // converges quickly
+  bool high = mantissa > 1.41421356f;
+  mantissa = high ? mantissa * 0.5f : mantissa;
+  exponent += high ? 1 : 0;
+
+  // log2(m) = 2 / ln2 * atanh((m - 1) / (m + 1)), odd series in t
+  float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+  float t2 = t * t;
+
+  constexpr float c1 = 2.88539008f;
+  constexpr float c3 = 0.961796694f;
+  constexpr float c5 = 0.577078016f;
+  constexpr float c7 = 0.412198583f;
+  constexpr float c9 = 0.320598898f;
+  float p = t * (c1 + t2 * (c3 + t2 * (c5 + t2 * (c7 + t2 * c9))));
+
+  return float(exponent) + p;
+}
+
+inline float dbToGain(float decibels) noexcept {
+  // 10^(dB / 20) = 2^(dB * log2(10) / 20)
+  constexpr float log2Of10Over20 = 0.166096405f;
+  float gain = exp2(decibels * log2Of10Over20);
+  return decibels > minusInfinityDb ? gain : 0.0f;
+}
+
+inline float gainToDb(float gain) noexcept {
+  // 20 * log10(g) = 20 * log10(2) * log2(g)
+  constexpr float twentyLog10Of2 = 6.02059991f;
+  float decibels = twentyLog10Of2 * log2(juce::jmax(gain, 1.0e-30f));
+  return juce::jmax(decibels, minusInfinityDb);
+}
+
+inline float tanh(float x) noexcept {
+  // tanh(x) = 1 - 2 / (e^2x + 1), already 1.0f in float beyond |x| = 9
+  constexpr float twoOverLn2 = 2.88539008f;
+  x = juce::jlimit(-9.0f, 9.0f, x);
+  return 1.0f - 2.0f / (exp2(x * twoOverLn2) + 1.0f);
+}
+
+/*
+ SIMD versions, four floats at a time. Same algorithms and error bounds as
+ the scalar ones above, written against the few operations each platform
+ has to provide. Without SSE2 or AArch64 NEON the block functions below
+ fall back to the scalar code.
+*/
+#if JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON && defined(__aarch64__))
+#define FASTMATH_HAS_SIMD 1
+
+namespace simd {
+#if JUCE_USE_SSE_INTRINSICS
+using Vec = __m128;
+using IntVec = __m128i;
+
+inline Vec load(const float *p) noexcept { return _mm_loadu_ps(p); }
+inline void store(float *p, Vec a) noexcept { _mm_storeu_ps(p, a); }
+inline Vec set(float a) noexcept { return _mm_set1_ps(a); }
+inline Vec add(Vec a, Vec b) noexcept { return _mm_add_ps(a, b); }
+inline Vec sub(Vec a, Vec b) noexcept { return _mm_sub_ps(a, b); }
+inline Vec mul(Vec a, Vec b) noexcept { return _mm_mul_ps(a, b); }
+inline Vec div(Vec a, Vec b) noexcept { return _mm_div_ps(a, b); }
+inline Vec min(Vec a, Vec b) noexcept { return _mm_min_ps(a, b); }
+inline Vec max(Vec a, Vec b) noexcept { return _mm_max_ps(a, b); }
+
+// All bits set in the lanes where a > b
+inline Vec greater(Vec a, Vec b) noexcept { return _mm_cmpgt_ps(a, b); }
+inline Vec select(Vec mask, Vec a, Vec b) noexcept {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline IntVec floorToInt(Vec a) noexcept {
+  // Truncation rounds up for negative values, step those back by one
+  IntVec n = _mm_cvttps_epi32(a);
+  Vec roundedUp = _mm_cmplt_ps(a, _mm_cvtepi32_ps(n));
+  return _mm_add_epi32(n, _mm_castps_si128(roundedUp));
+}
+
+inline Vec toFloat(IntVec a) noexcept { return _mm_cvtepi32_ps(a); }
+inline IntVec setInt(int a) noexcept { return _mm_set1_epi32(a); }
+inline IntVec addInt(IntVec a, IntVec b) noexcept {
+  return _mm_add_epi32(a, b);
+}
+inline IntVec andInt(IntVec a, IntVec b) noexcept {
+  return _mm_and_si128(a, b);
+}
+inline IntVec orInt(IntVec a, IntVec b) noexcept { return _mm_or_si128(a, b); }
+inline IntVec shiftLeft23(IntVec a) noexcept { return _mm_slli_epi32(a, 23); }
+inline IntVec shiftRight23(IntVec a) noexcept { return _mm_srli_epi32(a, 23); }
+inline Vec asFloat(IntVec a) noexcept { return _mm_castsi128_ps(a); }
+inline IntVec asInt(Vec a) noexcept { return _mm_castps_si128(a); }
+#else
+using Vec = float32x4_t;
+using IntVec = int32x4_t;
+
+inline Vec load(const float *p) noexcept { return vld1q_f32(p); }
+inline void store(float *p, Vec a) noexcept { vst1q_f32(p, a); }
+inline Vec set(float a) noexcept { return vdupq_n_f32(a); }
+inline Vec add(Vec a, Vec b) noexcept { return vaddq_f32(a, b); }
+inline Vec sub(Vec a, Vec b) noexcept { return vsubq_f32(a, b); }
+inline Vec mul(Vec a, Vec b) noexcept { return vmulq_f32(a, b); }
+inline Vec div(Vec a, Vec b) noexcept { return vdivq_f32(a, b); }
+inline Vec min(Vec a, Vec b) noexcept { return vminq_f32(a, b); }
+inline Vec max(Vec a, Vec b) noexcept { return vmaxq_f32(a, b); }
+
+// All bits set in the lanes where a > b
+inline Vec greater(Vec a, Vec b) noexcept {
+  return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+}
+inline Vec select(Vec mask, Vec a, Vec b) noexcept {
+  return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+
+inline IntVec floorToInt(Vec a) noexcept { return vcvtmq_s32_f32(a); }
+inline Vec toFloat(IntVec a) noexcept { return vcvtq_f32_s32(a); }
+inline IntVec setInt(int a) noexcept { return vdupq_n_s32(a); }
+inline IntVec addInt(IntVec a, IntVec b) noexcept { return vaddq_s32(a, b); }
+inline IntVec andInt(IntVec a, IntVec b) noexcept { return vandq_s32(a, b); }
+inline IntVec orInt(IntVec a, IntVec b) noexcept { return vorrq_s32(a, b); }
+inline IntVec shiftLeft23(IntVec a) noexcept { return vshlq_n_s32(a, 23); }
+inline IntVec shiftRight23(IntVec a) noexcept {
+  return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), 23));
+}
+inline Vec asFloat(IntVec a) noexcept { return vreinterpretq_f32_s32(a); }
+inline IntVec asInt(Vec a) noexcept { return vreinterpretq_s32_f32(a); }
+#endif
+
+constexpr int width = 4;
+
+inline Vec exp2(Vec x) noexcept {
+  x = min(max(x, set(-126.0f)), set(126.0f));
+
+  IntVec n = floorToInt(add(x, set(0.5f)));
+  Vec f = sub(x, toFloat(n));
+
+  Vec p = set(0.000154035304f);
+  p = add(mul(p, f), set(0.00133335581f));
+  p = add(mul(p, f), set(0.00961812911f));
+  p = add(mul(p, f), set(0.0555041087f));
+  p = add(mul(p, f), set(0.240226507f));
+  p = add(mul(p, f), set(0.693147181f));
+  p = add(mul(p, f), set(1.0f));
+
+  Vec scale = asFloat(shiftLeft23(addInt(n, setInt(127))));
+  return mul(p, scale);
+}
+
+inline Vec log2(Vec x) noexcept {
+  IntVec bits = asInt(x);
+  IntVec exponent =
+      addInt(andInt(shiftRight23(bits), setInt(0xff)), setInt(-127));
+  Vec mantissa = asFloat(
+      orInt(andInt(bits, setInt(0x007fffff)), setInt(0x3f800000)));
+
+  Vec high = greater(mantissa, set(1.41421356f));
+  mantissa = select(high, mul(mantissa, set(0.5f)), mantissa);
+  // Mask lanes are -1 as integers
+  exponent = addInt(exponent, andInt(asInt(high), setInt(1)));
+
+  Vec t = div(sub(mantissa, set(1.0f)), add(mantissa, set(1.0f)));
+  Vec t2 = mul(t, t);
+
+  Vec p = set(0.320598898f);
+  p = add(mul(p, t2), set(0.412198583f));
+  p = add(mul(p, t2), set(0.577078016f));
+  p = add(mul(p, t2), set(0.961796694f));
+  p = add(mul(p, t2), set(2.88539008f));
+
+  return add(toFloat(exponent), mul(t, p));
+}
+
+inline Vec dbToGain(Vec decibels) noexcept {
+  Vec gain = exp2(mul(decibels, set(0.166096405f)));
+  return select(greater(decibels, set(minusInfinityDb)), gain, set(0.0f));
+}
+
+inline Vec gainToDb(Vec gain) noexcept {
+  Vec decibels = mul(set(6.02059991f), log2(max(gain, set(1.0e-30f))));
+  return max(decibels, set(minusInfinityDb));
+}
+
+inline Vec tanh(Vec x) noexcept {
+  x = min(max(x, set(-9.0f)), set(9.0f));
+  Vec e = exp2(mul(x, set(2.88539008f)));
+  return sub(set(1.0f), div(set(2.0f), add(e, set(1.0f))));
+}
+} // namespace simd
+#else
+#define FASTMATH_HAS_SIMD 0
+#endif
+
+/*
+ Block versions, in-place use (dest == source) is fine.
+*/
+#if FASTMATH_HAS_SIMD
+#define FASTMATH_BLOCK_FUNCTION(name)                                          \
+  inline void name(float *dest, const float *source,                           \
+                   int numSamples) noexcept {                                  \
+    int i = 0;                                                                 \
+    for (; i + simd::width <= numSamples; i += simd::width)                    \
+      simd::store(dest + i, simd::name(simd::load(source + i)));               \
+    for (; i < numSamples; ++i)                                                \
+      dest[i] = name(source[i]);                                               \
+  }
+#else
+#define FASTMATH_BLOCK_FUNCTION(name)                                          \
+  inline void name(float *dest, const float *source,                           \
+                   int numSamples) noexcept {                                  \
+    for (int i = 0; i < numSamples; ++i)                                       \
+      dest[i] = name(source[i]);                                               \
+  }
+#endif
+
+FASTMATH_BLOCK_FUNCTION(exp2)
+FASTMATH_BLOCK_FUNCTION(log2)
+FASTMATH_BLOCK_FUNCTION(dbToGain)
+FASTMATH_BLOCK_FUNCTION(gainToDb)
+FASTMATH_BLOCK_FUNCTION(tanh)
+
+#undef FASTMATH_BLOCK_FUNCTION
+
+} // namespace FastMath
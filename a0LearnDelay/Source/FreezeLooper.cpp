@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    FreezeLooper.cpp
+    Created: 19 Oct 2026 7:26:41pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "FreezeLooper.h"
+#include "DelayCrossfade.h"
+
+void FreezeLooper::prepareToPlay(double sampleRate) {
+  int newLength =
+      juce::jmax(1, int(std::round(fadeLengthInSeconds * sampleRate)));
+
+  if (newLength != fadeTableLength) {
+    fadeTableLength = newLength;
+    DelayCrossfade::fillEqualPowerTable(table, fadeTableLength);
+  }
+
+  reset();
+}
+
+void FreezeLooper::reset() noexcept {
+  state = State::IDLE;
+  delayLine = nullptr;
+}
+
+void FreezeLooper::start(PooledDelayLine &newDelayLine) noexcept {
+  if (state == State::FROZEN || state == State::RETURNING)
+    return;
+
+  /*
+   Frozen again during the release, the release fade runs back to the
+   loop. Only when the delay line writes could reach the loop before the
+   fade is back is a new loop taken.
+  */
+  if (state == State::RELEASING) {
+    int room = delayLine->getBufferSize() - loopLength - loopFadeLength;
+    if (numWritten + releasePosition <= room) {
+      state = State::RETURNING;
+      return;
+    }
+  }
+
+  delayLine = &newDelayLine;
+
+  int size = delayLine->getBufferSize();
+  int delayInSamples = int(std::round(delayLine->getDelay()));
+  loopLength = juce::jlimit(1, size - 1, delayInSamples);
+
+  // Crossfade reads up to loopFadeLength samples from before the loop start,
+  // and it cannot be longer than half the loop
+  loopFadeLength =
+      juce::jmin(fadeTableLength, loopLength / 2, size - loopLength);
+  loopFadeLength = juce::jmax(1, loopFadeLength);
+
+  newDelayLine.clearStale(loopLength + loopFadeLength);
+
+  int writePosition = delayLine->getWritePosition(0);
+  base = writePosition + 1 == size ? 0 : writePosition + 1;
+
+  position = 0;
+  numWritten = 0;
+  state = State::FROZEN;
+}
+
+void FreezeLooper::stop() noexcept {
+  // Carries on from where the fade back to the loop got to
+  if (state == State::RETURNING) {
+    state = State::RELEASING;
+    return;
+  }
+
+  if (state != State::FROZEN)
+    return;
+
+  releasePosition = 0;
+  state = State::RELEASING;
+}
+
+void FreezeLooper::nextReleaseGains(float &loopGain,
+                                    float &delayGain) noexcept {
+  // Called once for every sample pushed into the delay line
+  ++numWritten;
+
+  if (state == State::RETURNING) {
+    // Back down to only the loop, which then plays on frozen
+    if (releasePosition > 0)
+      --releasePosition;
+
+    if (releasePosition == 0)
+      state = State::FROZEN;
+  }
+
+  delayGain = table[size_t(releasePosition)];
+  loopGain = table[size_t(fadeTableLength - releasePosition)];
+
+  if (state == State::RELEASING && ++releasePosition == fadeTableLength)
+    state = State::IDLE;
+}
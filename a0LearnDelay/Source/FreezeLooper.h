@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    FreezeLooper.h
+    Created: 19 Oct 2026 7:26:41pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PooledDelayLine.h"
+#include <JuceHeader.h>
+
+/*
+ Infinite hold of the delay line contents.
+
+ On start the last delay-time worth of audio in the delay line becomes a
+ loop. The delay line itself is left untouched (no writes, no reads), the
+ loop is played straight out of its buffer. Playback starts at the sample
+ the delay line would have returned next, so entering the freeze is
+ seamless. The loop boundary is hidden with a short equal-power crossfade
+ into the audio that came just before the loop start.
+
+ On stop the loop keeps playing while it fades out against the delay line
+ output over the same fade length. Freezing again before that fade is done
+ runs it back to the same loop, which the release has not overwritten.
+*/
+class FreezeLooper {
+public:
+  FreezeLooper() = default;
+
+  void prepareToPlay(double sampleRate);
+  void reset() noexcept;
+
+  // Loop length is the current delay of the delay line
+  void start(PooledDelayLine &delayLine) noexcept;
+  void stop() noexcept;
+
+  // Only the loop is played
+  bool isFrozen() const noexcept { return state == State::FROZEN; }
+
+  // The loop is blended with the delay line output, fading either way
+  bool isReleasing() const noexcept {
+    return state == State::RELEASING || state == State::RETURNING;
+  }
+
+  // Frozen, or on the way back to it after freezing during the release
+  bool isFreezing() const noexcept {
+    return state == State::FROZEN || state == State::RETURNING;
+  }
+
+  float readSample(int channel) const noexcept {
+    const float *samples = delayLine->getData() + channel;
+    int stride = delayLine->getNumChannels();
+    int size = delayLine->getBufferSize();
+
+    // Oldest sample of the loop is played first
+    int index = base + loopLength - 1 - position;
+    if (index >= size)
+      index -= size;
+
+    float sample = samples[index * stride];
+
+    int fadeStart = loopLength - loopFadeLength;
+    if (position >= fadeStart) {
+      int i = (position - fadeStart) * fadeTableLength / loopFadeLength;
+      int before = (index + loopLength) % size;
+      sample = sample * table[size_t(fadeTableLength - i)] +
+               samples[before * stride] * table[size_t(i)];
+    }
+
+    return sample;
+  }
+
+  // Moves the loop on by one sample
+  void advance() noexcept {
+    if (++position == loopLength)
+      position = 0;
+  }
+
+  // While releasing, gains for the loop and for the delay line output.
+  // Advances the release fade by one sample, forward or back.
+  void nextReleaseGains(float &loopGain, float &delayGain) noexcept;
+
+  static constexpr double fadeLengthInSeconds = 0.01;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FreezeLooper)
+
+  enum class State { IDLE, FROZEN, RELEASING, RETURNING };
+  State state = State::IDLE;
+
+  const PooledDelayLine *delayLine = nullptr;
+
+  // Equal-power fade, see DelayCrossfade::fillEqualPowerTable
+  std::vector<float> table;
+  int fadeTableLength = 0;
+
+  // Buffer index of the most recent sample when the freeze started
+  int base = 0;
+
+  int loopLength = 1;
+  int loopFadeLength = 1;
+  int position = 0;
+
+  int releasePosition = 0;
+
+  // Samples pushed into the delay line since the loop was taken. They go
+  // to the indices below base, the loop and its fade lie above.
+  int numWritten = 0;
+};
@@ -0,0 +1,547 @@
+/*
+  ==============================================================================
+
+    LongDelayLine.cpp
+    Created: 20 Oct 2026 6:12:40pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "LongDelayLine.h"
+
+#if JUCE_MAC || JUCE_LINUX || JUCE_ANDROID || JUCE_BSD
+#include <sys/mman.h>
+#define LONG_DELAY_HAS_MMAN 1
+#else
+#define LONG_DELAY_HAS_MMAN 0
+#endif
+
+#if JUCE_LINUX || JUCE_ANDROID
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static constexpr size_t chunkBytes =
+    size_t(LongDelayLine::chunkSize) * 2 * sizeof(float);
+
+// A chunk stays resident this long after the last head has left it, far
+// longer than a block, so a head is never evicted from under the audio
+// thread between publishing its position and the thread seeing it
+static constexpr juce::uint32 evictAfterMilliseconds = 250;
+
+// The file has to be on disk. /tmp is often RAM backed tmpfs on Linux,
+// /var/tmp is meant for larger files and stays on disk.
+static juce::File getFileDirectory() {
+#if JUCE_LINUX || JUCE_BSD
+  juce::File varTmp("/var/tmp");
+  if (varTmp.isDirectory() && varTmp.hasWriteAccess())
+    return varTmp;
+#endif
+  return juce::File::getSpecialLocation(juce::File::tempDirectory);
+}
+
+// Every block of the file is allocated up front. In a sparse file the
+// write head would allocate them in the page faults of the audio thread.
+static bool allocateFile(const juce::File &file, size_t bytes) {
+#if JUCE_LINUX || JUCE_ANDROID
+  int fd = open(file.getFullPathName().toRawUTF8(), O_RDWR);
+  if (fd >= 0) {
+    bool allocated = posix_fallocate(fd, 0, off_t(bytes)) == 0;
+    close(fd);
+    if (allocated)
+      return true;
+  }
+#endif
+
+  // Otherwise, or if the file system cannot, zeros are written out
+  juce::FileOutputStream stream(file);
+  if (stream.failedToOpen() || !stream.setPosition(0))
+    return false;
+
+  juce::HeapBlock<char> zeros(chunkBytes, true);
+  for (size_t written = 0; written < bytes; written += chunkBytes)
+    if (!stream.write(zeros, juce::jmin(chunkBytes, bytes - written)))
+      return false;
+
+  stream.flush();
+  return stream.getStatus().wasOk();
+}
+
+LongDelayLine::LongDelayLine() : juce::Thread("Long Delay Residency") {
+  for (auto &head : heads)
+    head.store(-1);
+}
+
+LongDelayLine::~LongDelayLine() { releaseResources(); }
+
+void LongDelayLine::prepareToPlay(double sampleRate,
+                                  double maxDelayInSeconds) {
+  int newMaxDelayFrames = int(std::ceil(maxDelayInSeconds * sampleRate));
+
+  // The file layout depends on the sample rate, the same rate keeps it
+  if (sampleRate != preparedSampleRate ||
+      newMaxDelayFrames != maxDelayFrames) {
+    releaseResources();
+
+    preparedSampleRate = sampleRate;
+    maxDelayFrames = newMaxDelayFrames;
+    windowFrames = int(std::ceil(windowInSeconds * sampleRate));
+
+    // The read heads never reach into the window ahead of the write head
+    int frames = maxDelayFrames + 2 * windowFrames + chunkSize;
+    numChunks = (frames + chunkSize - 1) / chunkSize;
+    totalFrames = numChunks * chunkSize;
+
+    fadeLength = juce::jmax(
+        1, int(std::round(DelayCrossfade::fadeLengthInSeconds * sampleRate)));
+    DelayCrossfade::fillEqualPowerTable(crossfadeTable, fadeLength);
+
+    loopTableLength =
+        juce::jmax(1, int(std::round(loopFadeLengthInSeconds * sampleRate)));
+    DelayCrossfade::fillEqualPowerTable(loopTable, loopTableLength);
+
+    writePosition = 0;
+  }
+
+  reset();
+
+  if (enabled && !isThreadRunning())
+    startThread();
+}
+
+void LongDelayLine::releaseResources() {
+  stopThread(1000);
+
+  // Nothing else touches the mapping with the thread stopped
+  deleteMapping();
+}
+
+void LongDelayLine::setEnabled(bool shouldBeEnabled) {
+  enabled = shouldBeEnabled;
+
+  if (!enabled)
+    releaseResources();
+  else if (preparedSampleRate > 0.0 && !isThreadRunning())
+    startThread();
+}
+
+void LongDelayLine::reset() noexcept {
+  numWritten = 0;
+
+  fadePosition = fadeLength;
+  currentDelay = 0;
+  nextDelay = 0;
+
+  state = State::IDLE;
+
+  active.store(false);
+  acknowledgedDelay.store(0);
+
+  heads[0].store(writePosition);
+  for (size_t i = 1; i < heads.size(); ++i)
+    heads[i].store(-1);
+}
+
+//==============================================================================
+bool LongDelayLine::createMapping() {
+  size_t bytes = size_t(numChunks) * chunkBytes;
+
+  file = std::make_unique<juce::TemporaryFile>(
+      getFileDirectory().getChildFile("a0LearnDelay.delay"));
+
+  if (!file->getFile().create() || !allocateFile(file->getFile(), bytes))
+    return false;
+
+  mapping = std::make_unique<juce::MemoryMappedFile>(
+      file->getFile(), juce::MemoryMappedFile::readWrite);
+  if (mapping->getData() == nullptr || mapping->getSize() < bytes)
+    return false;
+
+  resident.reset(new std::atomic<bool>[size_t(numChunks)]);
+  for (int chunk = 0; chunk < numChunks; ++chunk)
+    resident[size_t(chunk)].store(false);
+
+  locked.assign(size_t(numChunks), false);
+  writable.assign(size_t(numChunks), false);
+  lastNeeded.assign(size_t(numChunks), 0);
+
+  mappedData.store(static_cast<float *>(mapping->getData()),
+                   std::memory_order_release);
+  return true;
+}
+
+void LongDelayLine::deleteMapping() {
+  mappedData.store(nullptr);
+
+  // A block that loaded the data before it was unpublished finishes first
+  while (processing.load())
+    juce::Thread::yield();
+
+  // Unmapping also unlocks, the file is deleted with the TemporaryFile
+  mapping.reset();
+  file.reset();
+
+  resident.reset();
+  locked.clear();
+  writable.clear();
+  lastNeeded.clear();
+  mappingFailed = false;
+}
+
+void LongDelayLine::makeResident(int chunk) {
+  char *start = static_cast<char *>(mapping->getData()) +
+                size_t(chunk) * chunkBytes;
+
+  bool isLocked = false;
+#if LONG_DELAY_HAS_MMAN
+  // Faults the pages in and keeps them there, may fail without privileges
+  isLocked = mlock(start, chunkBytes) == 0;
+#endif
+
+  // Otherwise the pages are faulted in by touching one byte of each
+  if (!isLocked) {
+    volatile char sink = 0;
+    for (size_t offset = 0; offset < chunkBytes; offset += 4096)
+      sink = sink + start[offset];
+  }
+
+  locked[size_t(chunk)] = true;
+  resident[size_t(chunk)].store(true, std::memory_order_release);
+}
+
+void LongDelayLine::makeWritable(int chunk) {
+  char *start = static_cast<char *>(mapping->getData()) +
+                size_t(chunk) * chunkBytes;
+
+  bool isPopulated = false;
+#if defined(MADV_POPULATE_WRITE)
+  // Write faults the pages without touching their contents, Linux 5.14 on
+  isPopulated = madvise(start, chunkBytes, MADV_POPULATE_WRITE) == 0;
+#endif
+
+  // Otherwise one float of each page is written back as it is. Only ever
+  // called for chunks no head is reading or writing.
+  if (!isPopulated) {
+    for (size_t offset = 0; offset < chunkBytes; offset += 4096) {
+      auto *sample = reinterpret_cast<volatile float *>(start + offset);
+      *sample = *sample;
+    }
+  }
+
+  writable[size_t(chunk)] = true;
+}
+
+void LongDelayLine::evict(int chunk) {
+  resident[size_t(chunk)].store(false);
+  locked[size_t(chunk)] = false;
+  writable[size_t(chunk)] = false;
+
+#if LONG_DELAY_HAS_MMAN
+  // Written back in the background, then dropped from RAM
+  char *start = static_cast<char *>(mapping->getData()) +
+                size_t(chunk) * chunkBytes;
+
+  msync(start, chunkBytes, MS_ASYNC);
+  munlock(start, chunkBytes);
+  madvise(start, chunkBytes, MADV_DONTNEED);
+#endif
+}
+
+void LongDelayLine::keepResident(int frame) {
+  juce::uint32 now = juce::Time::getMillisecondCounter();
+
+  // One chunk behind the head and the window ahead of it
+  int first = wrap(frame - chunkSize) / chunkSize;
+  int count = (chunkSize + windowFrames) / chunkSize + 2;
+
+  for (int i = 0; i < juce::jmin(count, numChunks); ++i) {
+    int chunk = (first + i) % numChunks;
+    lastNeeded[size_t(chunk)] = now;
+
+    if (!locked[size_t(chunk)])
+      makeResident(chunk);
+  }
+}
+
+void LongDelayLine::keepWritable(int frame) {
+  /*
+   Resident pages of a shared mapping are still write protected until
+   they are first written, and again once writeback has cleaned them. The
+   write head would take those faults on the audio thread, so the chunks
+   ahead of it are write faulted here, once per pass through the file.
+
+   The audio thread never touches a chunk that is not resident yet. Of
+   the resident ones, the chunk of the write head and the next one may be
+   written by the current block, the ones after that are safe.
+  */
+  int headChunk = frame / chunkSize;
+  int count = windowFrames / chunkSize + 2;
+
+  for (int i = 0; i < juce::jmin(count, numChunks); ++i) {
+    int chunk = (headChunk + i) % numChunks;
+
+    if (!writable[size_t(chunk)] &&
+        (i >= 2 || !resident[size_t(chunk)].load()))
+      makeWritable(chunk);
+  }
+
+  // Cleaned by writeback before the next pass, has to be faulted again
+  int behind = (headChunk + numChunks - 1) % numChunks;
+  writable[size_t(behind)] = false;
+}
+
+void LongDelayLine::updateResidency() {
+  if (active.load()) {
+    // Before the write window is published as resident
+    keepWritable(heads[0].load());
+
+    for (auto &head : heads) {
+      int frame = head.load();
+      if (frame >= 0)
+        keepResident(frame);
+    }
+
+    // Acknowledged once the chunks around the new read head are in
+    int delay = requestedDelay.load();
+    if (delay > 0) {
+      keepResident(wrap(heads[0].load() - delay));
+      acknowledgedDelay.store(delay, std::memory_order_release);
+    }
+  }
+
+  juce::uint32 now = juce::Time::getMillisecondCounter();
+
+  for (int chunk = 0; chunk < numChunks; ++chunk) {
+    if (locked[size_t(chunk)] &&
+        now - lastNeeded[size_t(chunk)] > evictAfterMilliseconds)
+      evict(chunk);
+  }
+}
+
+void LongDelayLine::run() {
+  while (!threadShouldExit()) {
+    bool isActive = active.load();
+
+    // Created on first use, instances that never go long never touch disk
+    if (isActive && mapping == nullptr && !mappingFailed) {
+      if (!createMapping()) {
+        deleteMapping();
+        mappingFailed = true;
+      }
+    }
+
+    if (mappedData.load() != nullptr)
+      updateResidency();
+
+    // The window gives the thread a second, polling every 10 ms leaves
+    // plenty of margin
+    wait(isActive ? 10 : 100);
+  }
+}
+
+//==============================================================================
+bool LongDelayLine::isResident(int frame, int numFrames) const noexcept {
+  if (numFrames <= 0)
+    return true;
+
+  int first = wrap(frame) / chunkSize;
+  int last = wrap(frame + numFrames - 1) / chunkSize;
+
+  for (int chunk = first;; chunk = (chunk + 1) % numChunks) {
+    if (!resident[size_t(chunk)].load(std::memory_order_acquire))
+      return false;
+    if (chunk == last)
+      return true;
+  }
+}
+
+float LongDelayLine::readLoop(const float *data, int channel) const noexcept {
+  // Oldest frame of the loop is played first, ages count back from where
+  // the write head stopped
+  int age = loopLength - loopPosition;
+  float sample = age <= loopWritten
+                     ? data[size_t(2 * wrap(loopEnd - age) + channel)]
+                     : 0.0f;
+
+  // Loop boundary crossfades into the audio from just before the loop
+  int fadeStart = loopLength - loopFadeLength;
+  if (loopPosition >= fadeStart) {
+    int i = (loopPosition - fadeStart) * loopTableLength / loopFadeLength;
+    int before = age + loopLength;
+    float beforeSample =
+        before <= loopWritten
+            ? data[size_t(2 * wrap(loopEnd - before) + channel)]
+            : 0.0f;
+
+    sample = sample * loopTable[size_t(loopTableLength - i)] +
+             beforeSample * loopTable[size_t(i)];
+  }
+
+  return sample;
+}
+
+void LongDelayLine::startLoop(int delay) noexcept {
+  loopLength = delay;
+
+  // The crossfade cannot be longer than half the loop
+  loopFadeLength = juce::jlimit(1, juce::jmax(1, loopLength / 2),
+                                loopTableLength);
+
+  loopEnd = writePosition;
+  loopWritten = numWritten;
+  loopPosition = 0;
+  state = State::FROZEN;
+}
+
+bool LongDelayLine::blockIsResident(int numSamples) const noexcept {
+  if (state != State::FROZEN) {
+    if (!isResident(writePosition, numSamples))
+      return false;
+
+    if (currentDelay > 0 &&
+        !isResident(writePosition - currentDelay, numSamples))
+      return false;
+
+    if (isFading() && !isResident(writePosition - nextDelay, numSamples))
+      return false;
+  }
+
+  if (state != State::IDLE) {
+    // Loop up to its end, then from the seam before its start
+    int loopStart = wrap(loopEnd - loopLength);
+    int untilEnd = juce::jmin(numSamples, loopLength - loopPosition);
+
+    if (!isResident(loopStart + loopPosition, untilEnd) ||
+        !isResident(loopStart - loopFadeLength,
+                    loopFadeLength + juce::jmin(numSamples, loopLength)))
+      return false;
+  }
+
+  return true;
+}
+
+void LongDelayLine::process(const juce::AudioBuffer<float> &input,
+                            juce::AudioBuffer<float> &output, int numSamples,
+                            int delayInSamples, bool freeze) noexcept {
+  active.store(true);
+  requestedDelay.store(juce::jlimit(1, maxDelayFrames, delayInSamples));
+
+  // Freeze starts and stops at block boundaries, never during a fade
+  if (freeze && state == State::IDLE && currentDelay > 0 && !isFading()) {
+    startLoop(currentDelay);
+  } else if (!freeze && state == State::FROZEN) {
+    releasePosition = 0;
+    state = State::RELEASING;
+  }
+
+  // Only a delay time the thread has made resident is faded to. The very
+  // first one is taken as is, there is nothing to fade out from yet.
+  int acknowledged = acknowledgedDelay.load(std::memory_order_acquire);
+
+  if (state == State::IDLE && acknowledged > 0 && !isFading() &&
+      acknowledged != currentDelay) {
+    if (currentDelay == 0) {
+      currentDelay = acknowledged;
+    } else {
+      nextDelay = acknowledged;
+      fadePosition = 0;
+    }
+  }
+
+  // Set before the data is loaded, deleteMapping checks it after
+  processing.store(true);
+  float *data = mappedData.load();
+
+  // Offline the thread is woken up and waited for, for a second at most
+  if (nonRealtime) {
+    for (int attempt = 0;
+         attempt < 1000 && (data == nullptr || !blockIsResident(numSamples));
+         ++attempt) {
+      notify();
+      juce::Thread::sleep(1);
+      data = mappedData.load();
+    }
+  }
+
+  if (data == nullptr || !blockIsResident(numSamples)) {
+    for (int channel = 0; channel < 2; ++channel)
+      output.clear(channel, 0, numSamples);
+
+    processing.store(false);
+    return;
+  }
+
+  const float *inputL = input.getReadPointer(0);
+  const float *inputR = input.getReadPointer(1);
+  float *outputL = output.getWritePointer(0);
+  float *outputR = output.getWritePointer(1);
+
+  for (int sample = 0; sample < numSamples; ++sample) {
+    float wetL = 0.0f;
+    float wetR = 0.0f;
+
+    if (state == State::FROZEN) {
+      // Freeze : nothing is written, the loop plays straight out of the file
+      wetL = readLoop(data, 0);
+      wetR = readLoop(data, 1);
+
+      if (++loopPosition == loopLength)
+        loopPosition = 0;
+    } else {
+      float *frame = data + size_t(2 * writePosition);
+      frame[0] = inputL[sample];
+      frame[1] = inputR[sample];
+
+      if (isFading()) {
+        float fadeIn = crossfadeTable[size_t(fadePosition)];
+        float fadeOut = crossfadeTable[size_t(fadeLength - fadePosition)];
+
+        wetL = readFrame(data, 0, currentDelay) * fadeOut +
+               readFrame(data, 0, nextDelay) * fadeIn;
+        wetR = readFrame(data, 1, currentDelay) * fadeOut +
+               readFrame(data, 1, nextDelay) * fadeIn;
+
+        // Once the fade completes the incoming head is the only head
+        if (++fadePosition == fadeLength)
+          currentDelay = nextDelay;
+      } else if (currentDelay > 0) {
+        wetL = readFrame(data, 0, currentDelay);
+        wetR = readFrame(data, 1, currentDelay);
+      }
+
+      // Fading from the loop back to the delay after a freeze
+      if (state == State::RELEASING) {
+        float delayGain = loopTable[size_t(releasePosition)];
+        float loopGain = loopTable[size_t(loopTableLength - releasePosition)];
+
+        wetL = wetL * delayGain + readLoop(data, 0) * loopGain;
+        wetR = wetR * delayGain + readLoop(data, 1) * loopGain;
+
+        if (++loopPosition == loopLength)
+          loopPosition = 0;
+        if (++releasePosition == loopTableLength)
+          state = State::IDLE;
+      }
+
+      if (++writePosition == totalFrames)
+        writePosition = 0;
+      numWritten = juce::jmin(numWritten + 1, totalFrames);
+    }
+
+    outputL[sample] = wetL;
+    outputR[sample] = wetR;
+  }
+
+  // Positions for the thread to keep the windows around
+  bool looping = state != State::IDLE;
+  int loopStart = wrap(loopEnd - loopLength);
+
+  heads[0].store(writePosition);
+  heads[1].store(currentDelay > 0 ? wrap(writePosition - currentDelay) : -1);
+  heads[2].store(isFading() ? wrap(writePosition - nextDelay) : -1);
+  heads[3].store(looping ? wrap(loopStart + loopPosition) : -1);
+  heads[4].store(looping ? wrap(loopStart - loopFadeLength) : -1);
+
+  processing.store(false);
+}
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    LongDelayLine.h
+    Created: 20 Oct 2026 6:12:40pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayCrossfade.h"
+#include <JuceHeader.h>
+
+/*
+ Stereo delay and looper of up to Parameters::maxLongDelayTime whose
+ buffer lives in a memory-mapped temporary file instead of RAM.
+
+ The file is split into chunks. A background thread keeps the chunks
+ around the write head and the read heads resident, locked into RAM
+ where the system allows it. Chunks no head has needed for a while are
+ written back and dropped from RAM, so only a few seconds of the buffer
+ take up memory whatever the delay time. Frames are stored interleaved
+ (L R L R ...), so every head streams through one run of pages.
+
+ The thread only runs while the long delay is switched on, see
+ setEnabled. The audio thread only touches chunks it has marked resident:
+    - The file is created and mapped by the thread the first time the
+      long delay is used, until then the output is silent
+    - A new delay time is made resident first, the audio thread only
+      crossfades to it once the thread has acknowledged it
+    - Every block checks the chunks it is about to touch and outputs
+      silence if the thread has fallen behind
+
+ The delay time changes with a crossfade, there is no glide. Freeze
+ stops the writes and loops the last delay time worth of audio, like
+ FreezeLooper does for the short delay line.
+*/
+class LongDelayLine : private juce::Thread {
+public:
+  LongDelayLine();
+  ~LongDelayLine() override;
+
+  void prepareToPlay(double sampleRate, double maxDelayInSeconds);
+
+  // Stops the thread, unmaps and deletes the file
+  void releaseResources();
+
+  // Not on the audio thread. Starts the thread, or stops it and deletes
+  // the file, waiting for a block in progress to finish with it.
+  void setEnabled(bool shouldBeEnabled);
+
+  // Forgets the contents, the buffer is cleared lazily. Until the next
+  // process call the thread lets the resident chunks go.
+  void reset() noexcept;
+
+  // Offline rendering has no deadline, blocks wait for the thread to make
+  // their chunks resident instead of dropping out
+  void setNonRealtime(bool isNonRealtime) noexcept {
+    nonRealtime = isNonRealtime;
+  }
+
+  // Reads the dry input and writes the delayed signal
+  void process(const juce::AudioBuffer<float> &input,
+               juce::AudioBuffer<float> &output, int numSamples,
+               int delayInSamples, bool freeze) noexcept;
+
+  // 16384 stereo frames, 128 kB
+  static constexpr int chunkSize = 1 << 14;
+
+  // Kept resident ahead of every head, the thread has this much time to
+  // catch up before the audio thread runs into a chunk that is not
+  static constexpr double windowInSeconds = 1.0;
+
+  // Loop seam crossfade, same as FreezeLooper
+  static constexpr double loopFadeLengthInSeconds = 0.01;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LongDelayLine)
+
+  // Write head, current and incoming read heads, loop play head and seam
+  static constexpr int numHeads = 5;
+
+  void run() override;
+
+  bool createMapping();
+  void deleteMapping();
+  void updateResidency();
+  void keepResident(int frame);
+  void makeResident(int chunk);
+  void keepWritable(int frame);
+  void makeWritable(int chunk);
+  void evict(int chunk);
+
+  bool isResident(int frame, int numFrames) const noexcept;
+  bool blockIsResident(int numSamples) const noexcept;
+
+  void startLoop(int delay) noexcept;
+  float readLoop(const float *data, int channel) const noexcept;
+
+  bool isFading() const noexcept { return fadePosition < fadeLength; }
+
+  int wrap(int frame) const noexcept {
+    if (frame < 0)
+      return frame + totalFrames;
+    if (frame >= totalFrames)
+      return frame - totalFrames;
+    return frame;
+  }
+
+  // Frame written distance frames before the write head
+  float readFrame(const float *data, int channel,
+                  int distance) const noexcept {
+    if (distance > numWritten)
+      return 0.0f;
+
+    return data[size_t(2 * wrap(writePosition - distance) + channel)];
+  }
+
+  double preparedSampleRate = 0.0;
+  int maxDelayFrames = 0;
+  int totalFrames = 0;
+  int numChunks = 0;
+  int windowFrames = 0;
+
+  // Owned by the thread, the mapping goes before the file it maps
+  std::unique_ptr<juce::TemporaryFile> file;
+  std::unique_ptr<juce::MemoryMappedFile> mapping;
+  std::vector<bool> locked;
+  std::vector<bool> writable;
+  std::vector<juce::uint32> lastNeeded;
+  bool mappingFailed = false;
+
+  // Published by the thread once the file is mapped
+  std::atomic<float *> mappedData{nullptr};
+  std::unique_ptr<std::atomic<bool>[]> resident;
+
+  // Set through setEnabled, the thread runs while prepared and enabled
+  bool enabled = false;
+
+  // Audio thread -> thread, heads are frame positions or -1 when unused
+  std::atomic<bool> active{false};
+  std::array<std::atomic<int>, numHeads> heads;
+  std::atomic<int> requestedDelay{0};
+
+  // Thread -> audio thread, a delay time whose chunks are resident
+  std::atomic<int> acknowledgedDelay{0};
+
+  // Set by the audio thread while a block uses the mapped data
+  std::atomic<bool> processing{false};
+
+  // Audio thread state, the frame that is written next
+  int writePosition = 0;
+  int numWritten = 0;
+
+  bool nonRealtime = false;
+
+  /*
+   Delay time crossfade, works like DelayCrossfade but on whole frames.
+   Minutes of delay are more samples than a float holds exactly.
+  */
+  std::vector<float> crossfadeTable;
+  int fadeLength = 0;
+  int fadePosition = 0;
+  int currentDelay = 0;
+  int nextDelay = 0;
+
+  enum class State { IDLE, FROZEN, RELEASING };
+  State state = State::IDLE;
+
+  // Loop seam and release fade, see DelayCrossfade::fillEqualPowerTable
+  std::vector<float> loopTable;
+  int loopTableLength = 0;
+
+  // Frame the write head stopped at and how much had been written then
+  int loopEnd = 0;
+  int loopWritten = 0;
+
+  int loopLength = 1;
+  int loopFadeLength = 1;
+  int loopPosition = 0;
+  int releasePosition = 0;
+};
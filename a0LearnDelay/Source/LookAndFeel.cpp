@@ -10,12 +10,16 @@
 
 #include "LookAndFeel.h"
 
-const juce::Typeface::Ptr Fonts::typeface =
-    juce::Typeface::createSystemTypefaceFor(BinaryData::LatoMedium_ttf,
-                                            BinaryData::LatoMedium_ttfSize);
+juce::Typeface::Ptr Fonts::getTypeface() {
+  // The first caller creates it, it is kept until the plug-in is unloaded
+  static const juce::Typeface::Ptr typeface =
+      juce::Typeface::createSystemTypefaceFor(BinaryData::LatoMedium_ttf,
+                                              BinaryData::LatoMedium_ttfSize);
+  return typeface;
+}
 
 juce::Font Fonts::getFont(float height) {
-  return juce::FontOptions(Fonts::typeface)
+  return juce::FontOptions(getTypeface())
       .withHeight(height)
       .withMetricsKind(juce::TypefaceMetricsKind::legacy);
 }
@@ -170,3 +174,9 @@ MainLookAndFeel::MainLookAndFeel() {
 juce::Font MainLookAndFeel::getLabelFont([[maybe_unused]] juce::Label &label) {
   return Fonts::getFont();
 }
+
+EditorResources::EditorResources()
+    : noise(juce::ImageCache::getFromMemory(BinaryData::Noise_png,
+                                            BinaryData::Noise_pngSize)),
+      logo(juce::ImageCache::getFromMemory(BinaryData::Logo_png,
+                                           BinaryData::Logo_pngSize)) {}
@@ -46,18 +46,14 @@ public:
   static juce::Font getFont(float height = 16.0f);
 
 private:
-  static const juce::Typeface::Ptr typeface;
+  // Created on the first call, a host scan never asks for a font
+  static juce::Typeface::Ptr getTypeface();
 };
 
 class RotaryKnobLookAndFeel : public juce::LookAndFeel_V4 {
 public:
   RotaryKnobLookAndFeel();
 
-  static RotaryKnobLookAndFeel *get() {
-    static RotaryKnobLookAndFeel instance;
-    return &instance;
-  }
-
   void drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height,
                         float sliderPos, float rotaryStartAngle,
                         float rotaryEndAngle, juce::Slider &slider) override;
@@ -88,3 +84,28 @@ public:
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainLookAndFeel)
 };
+
+/*
+ Everything the editor draws with that is worth creating only once.
+ Access it through juce::SharedResourcePointer<EditorResources>: it is
+ built when the first editor opens, shared by every editor in the process
+ and deleted when the last one closes. Hosts that only scan or run the
+ plug-in never create it.
+
+ Components using one of the look and feels reset it in their destructor,
+ before their pointer lets go of the resources.
+*/
+class EditorResources {
+public:
+  EditorResources();
+
+  // Decoded once instead of on every paint
+  juce::Image noise;
+  juce::Image logo;
+
+  RotaryKnobLookAndFeel rotaryKnobLF;
+  MainLookAndFeel mainLF;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditorResources)
+};
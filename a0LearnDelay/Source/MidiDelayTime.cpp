@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    MidiDelayTime.cpp
+    Created: 20 Oct 2026 10:14:52am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "MidiDelayTime.h"
+#include "Parameters.h"
+
+MidiDelayTime::MidiDelayTime() {
+  for (size_t note = 0; note < notePeriods.size(); ++note) {
+    double frequency = 440.0 * std::exp2((double(note) - 69.0) / 12.0);
+    notePeriods[note] = float(1000.0 / frequency);
+  }
+}
+
+void MidiDelayTime::prepareToPlay(double newSampleRate) {
+  // Measurements in progress start over. Hosts prepare again on transport
+  // starts and the like, the delay time the MIDI set stays unless the
+  // sample rate changed.
+  float keptDelayTime = newSampleRate == sampleRate ? delayTime : 0.0f;
+
+  sampleRate = newSampleRate;
+  reset();
+
+  delayTime = keptDelayTime;
+}
+
+void MidiDelayTime::reset() noexcept {
+  numEvents = 0;
+  nextEvent = 0;
+
+  delayTime = 0.0f;
+
+  blockStart = 0;
+  beatStart = -1;
+  lastClock = 0;
+  clockTicks = 0;
+  lastTap = -1;
+  tapDown = false;
+}
+
+void MidiDelayTime::parse(const juce::MidiBuffer &midiMessages,
+                          int numSamples) noexcept {
+  numEvents = 0;
+  nextEvent = 0;
+
+  // Clock ticks or taps further apart than this cannot make a delay time
+  double maxInterval = Parameters::maxDelayTime * 0.001 * sampleRate;
+
+  for (const auto metadata : midiMessages) {
+    if (metadata.numBytes < 1)
+      continue;
+
+    const juce::uint8 *data = metadata.data;
+    juce::int64 now = blockStart + metadata.samplePosition;
+
+    juce::uint8 status = data[0];
+
+    if (status == 0xf8) {
+      // Clock, 24 ticks per quarter note
+      if (beatStart >= 0 && double(now - lastClock) > maxInterval / 24.0)
+        beatStart = -1;
+
+      lastClock = now;
+
+      if (beatStart < 0) {
+        beatStart = now;
+        clockTicks = 0;
+      } else if (++clockTicks == 24) {
+        addEvent(metadata.samplePosition, double(now - beatStart));
+        beatStart = now;
+        clockTicks = 0;
+      }
+    } else if (status == 0xfa || status == 0xfc) {
+      // Start and stop, the next clock starts a new measurement
+      beatStart = -1;
+    } else if ((status & 0xf0) == 0x90 && metadata.numBytes >= 3) {
+      // Note on, velocity 0 is a note off
+      if (data[2] > 0)
+        addEvent(metadata.samplePosition,
+                 notePeriods[data[1] & 0x7f] * 0.001 * sampleRate);
+    } else if ((status & 0xf0) == 0xb0 && metadata.numBytes >= 3 &&
+               data[1] == tapController) {
+      bool down = data[2] >= 64;
+
+      // Only a press counts, holding the switch down does not repeat
+      if (down && !tapDown) {
+        if (lastTap >= 0 && double(now - lastTap) <= maxInterval)
+          addEvent(metadata.samplePosition, double(now - lastTap));
+
+        lastTap = now;
+      }
+
+      tapDown = down;
+    }
+  }
+
+  blockStart += numSamples;
+}
+
+void MidiDelayTime::addEvent(int sample, double delayInSamples) noexcept {
+  delayTime = float(delayInSamples * 1000.0 / sampleRate);
+  delayTime = juce::jmin(delayTime, Parameters::maxDelayTime);
+
+  // A full list keeps replacing its last event, the newest time still wins
+  if (numEvents == maxEvents)
+    --numEvents;
+
+  events[size_t(numEvents++)] = {sample, delayTime};
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    MidiDelayTime.h
+    Created: 20 Oct 2026 10:14:52am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Delay time from incoming MIDI:
+    - Note on : period of the note, e.g. A4 gives 1000 / 440 ms
+    - Clock : one quarter note at the tempo of the 24 ppqn clock,
+              measured over a whole beat
+    - Tap tempo : time between the last two presses on tapController
+
+ The MIDI buffer is parsed once at the start of the block, straight from
+ the raw bytes, into an event list that never allocates. processBlock
+ then picks the events up at their sample positions.
+*/
+class MidiDelayTime {
+public:
+  MidiDelayTime();
+
+  void prepareToPlay(double sampleRate);
+  void reset() noexcept;
+
+  void parse(const juce::MidiBuffer &midiMessages, int numSamples) noexcept;
+
+  // Delay time in milliseconds set by the events of the earlier blocks,
+  // kept by prepareToPlay at the same sample rate
+  bool hasDelayTime() const noexcept { return delayTime > 0.0f; }
+  float getDelayTime() const noexcept { return delayTime; }
+
+  // Returns true and the newest delay time if any events up to and
+  // including sample are still to be applied
+  bool nextDelayTime(int sample, float &newDelayTime) noexcept {
+    if (nextEvent == numEvents || events[size_t(nextEvent)].sample > sample)
+      return false;
+
+    while (nextEvent < numEvents && events[size_t(nextEvent)].sample <= sample)
+      newDelayTime = events[size_t(nextEvent++)].delayTime;
+
+    return true;
+  }
+
+  // General purpose controller 5, presses are values of 64 and up
+  static constexpr int tapController = 80;
+
+  static constexpr int maxEvents = 256;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiDelayTime)
+
+  struct Event {
+    int sample;
+    float delayTime;
+  };
+
+  void addEvent(int sample, double delayInSamples) noexcept;
+
+  std::array<Event, maxEvents> events;
+  int numEvents = 0;
+  int nextEvent = 0;
+
+  // Note periods in milliseconds
+  std::array<float, 128> notePeriods;
+
+  double sampleRate = 44100.0;
+  float delayTime = 0.0f;
+
+  // Absolute sample positions since reset()
+  juce::int64 blockStart = 0;
+
+  juce::int64 beatStart = -1;
+  juce::int64 lastClock = 0;
+  int clockTicks = 0;
+
+  juce::int64 lastTap = -1;
+  bool tapDown = false;
+};
@@ -0,0 +1,351 @@
+/*
+  ==============================================================================
+
+    MultibandDelay.cpp
+    Created: 19 Oct 2026 10:41:08pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "MultibandDelay.h"
+#include "FastMath.h"
+
+namespace {
+#if FASTMATH_HAS_SIMD
+using namespace FastMath::simd;
+#else
+// Plain lane loops with the same interface as FastMath::simd
+struct Vec {
+  float lanes[MultibandDelay::numLanes];
+};
+
+#define MULTIBAND_LANE_OP(name, op)                                            \
+  inline Vec name(Vec a, Vec b) noexcept {                                     \
+    for (int i = 0; i < MultibandDelay::numLanes; ++i)                         \
+      a.lanes[i] = a.lanes[i] op b.lanes[i];                                   \
+    return a;                                                                  \
+  }
+
+MULTIBAND_LANE_OP(add, +)
+MULTIBAND_LANE_OP(sub, -)
+MULTIBAND_LANE_OP(mul, *)
+
+#undef MULTIBAND_LANE_OP
+
+inline Vec load(const float *p) noexcept {
+  Vec a{};
+  std::copy(p, p + MultibandDelay::numLanes, a.lanes);
+  return a;
+}
+
+inline void store(float *p, Vec a) noexcept {
+  std::copy(a.lanes, a.lanes + MultibandDelay::numLanes, p);
+}
+
+inline Vec set(float value) noexcept {
+  Vec a{};
+  std::fill(a.lanes, a.lanes + MultibandDelay::numLanes, value);
+  return a;
+}
+#endif
+} // namespace
+
+MultibandDelay::~MultibandDelay() { releaseMemory(); }
+
+void MultibandDelay::prepareToPlay(double sampleRate, int maxDelayInSamples) {
+  // One frame more than the longest delay for the interpolation
+  int newNumFrames = maxDelayInSamples + 2;
+
+  // A buffer of the old layout goes, setEnabled acquires the new one
+  if (sampleRate != preparedSampleRate || newNumFrames != numFrames) {
+    releaseMemory();
+    numFrames = newNumFrames;
+  }
+
+  if (sampleRate != preparedSampleRate) {
+    preparedSampleRate = sampleRate;
+
+    // Same glide as the single band delay time, see Parameters
+    coeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
+
+    updateCoefficients();
+  }
+
+  reset();
+}
+
+void MultibandDelay::setEnabled(bool shouldBeEnabled) {
+  if (!shouldBeEnabled) {
+    releaseMemory();
+    return;
+  }
+
+  if (preparedSampleRate == 0.0 || memory.load() != nullptr)
+    return;
+
+  int stride = 0;
+  float *newMemory =
+      pool->acquire(preparedSampleRate, 1, numFrames * frameSize, stride);
+
+  // Out of memory, nothing is published and the multiband output stays
+  // silent. This runs on the message thread, there is no caller to throw to.
+  if (newMemory != nullptr)
+    memory.store(newMemory);
+}
+
+void MultibandDelay::releaseMemory() noexcept {
+  float *oldMemory = memory.exchange(nullptr);
+  if (oldMemory == nullptr)
+    return;
+
+  // A block that loaded the buffer before the exchange finishes with it
+  while (processing.load())
+    juce::Thread::yield();
+
+  pool->release(oldMemory);
+}
+
+void MultibandDelay::reset() noexcept {
+  writeFrame = 0;
+  numWritten = 0;
+
+  for (auto &channelStates : states)
+    for (auto &state : channelStates)
+      state = State{};
+
+  // Delay times jump to their targets and the levels fade in from silence
+  // with the next setBandParameters
+  std::fill(std::begin(levels), std::end(levels), 0.0f);
+  primed = false;
+}
+
+void MultibandDelay::setBands(
+    int newNumBands,
+    const std::array<float, Parameters::maxBands - 1> &crossoverFrequencies)
+    noexcept {
+  newNumBands = juce::jlimit(1, numLanes, newNumBands);
+
+  // The lanes get different filter chains, old state would pop
+  if (newNumBands != numBands) {
+    for (auto &channelStates : states)
+      for (auto &state : channelStates)
+        state = State{};
+  }
+
+  if (newNumBands != numBands || crossoverFrequencies != crossovers) {
+    numBands = newNumBands;
+    crossovers = crossoverFrequencies;
+    updateCoefficients();
+  }
+}
+
+void MultibandDelay::setBandParameters(
+    const std::array<float, Parameters::maxBands> &delayTimesInSamples,
+    const std::array<float, Parameters::maxBands> &newFeedbacks,
+    const std::array<float, Parameters::maxBands> &newLevels) noexcept {
+  for (int lane = 0; lane < numLanes; ++lane) {
+    bool active = lane < numBands;
+
+    targetDelays[lane] = delayTimesInSamples[size_t(lane)];
+    targetFeedbacks[lane] = active ? newFeedbacks[size_t(lane)] : 0.0f;
+    targetLevels[lane] = active ? newLevels[size_t(lane)] : 0.0f;
+  }
+
+  if (!primed) {
+    std::copy(std::begin(targetDelays), std::end(targetDelays), delays);
+    std::copy(std::begin(targetFeedbacks), std::end(targetFeedbacks),
+              feedbacks);
+    primed = true;
+  }
+}
+
+void MultibandDelay::updateCoefficients() noexcept {
+  numSections = 2 * (numBands - 1);
+
+  if (preparedSampleRate <= 0.0)
+    return;
+
+  float sampleRate = float(preparedSampleRate);
+
+  for (int crossover = 0; crossover < numBands - 1; ++crossover) {
+    /*
+     An LR4 section is two identical Butterworth biquads. The lowpass
+     and highpass of one crossover add up to a single Butterworth
+     allpass biquad, used on the bands below the crossover.
+    */
+    float frequency = juce::jlimit(20.0f, 0.45f * sampleRate,
+                                   crossovers[size_t(crossover)]);
+    float k = std::tan(juce::MathConstants<float>::pi * frequency /
+                       sampleRate);
+    float kk = k * k;
+    float norm = 1.0f / (1.0f + juce::MathConstants<float>::sqrt2 * k + kk);
+
+    float a1 = 2.0f * (kk - 1.0f) * norm;
+    float a2 = (1.0f - juce::MathConstants<float>::sqrt2 * k + kk) * norm;
+
+    auto &first = coefficients[size_t(2 * crossover)];
+    auto &second = coefficients[size_t(2 * crossover + 1)];
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+      float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+
+      if (lane >= numBands) {
+        // Unused lane, the filter outputs silence
+      } else if (lane == crossover) {
+        // Lowpass
+        b0 = kk * norm;
+        b1 = 2.0f * b0;
+        b2 = b0;
+      } else if (lane > crossover) {
+        // Highpass
+        b0 = norm;
+        b1 = -2.0f * norm;
+        b2 = norm;
+      }
+
+      bool allpass = lane < crossover;
+      bool silent = lane >= numBands;
+
+      first.b0[lane] = allpass ? a2 : b0;
+      first.b1[lane] = allpass ? a1 : b1;
+      first.b2[lane] = allpass ? 1.0f : b2;
+      first.a1[lane] = silent ? 0.0f : a1;
+      first.a2[lane] = silent ? 0.0f : a2;
+
+      // The allpass is a single biquad, the second one passes through
+      second.b0[lane] = allpass ? 1.0f : b0;
+      second.b1[lane] = allpass ? 0.0f : b1;
+      second.b2[lane] = allpass ? 0.0f : b2;
+      second.a1[lane] = allpass || silent ? 0.0f : a1;
+      second.a2[lane] = allpass || silent ? 0.0f : a2;
+    }
+  }
+}
+
+void MultibandDelay::process(const juce::AudioBuffer<float> &input,
+                             juce::AudioBuffer<float> &output,
+                             int numSamples) noexcept {
+  // Set before the buffer is loaded, releaseMemory checks it after
+  processing.store(true);
+  float *currentMemory = memory.load();
+
+  if (currentMemory != usedMemory) {
+    usedMemory = currentMemory;
+    writeFrame = 0;
+    numWritten = 0;
+  }
+
+  if (currentMemory == nullptr) {
+    for (int channel = 0; channel < numChannels; ++channel)
+      output.clear(channel, 0, numSamples);
+  } else if (numSamples > 0) {
+    for (int channel = 0; channel < numChannels; ++channel)
+      processChannel(currentMemory, channel, input.getReadPointer(channel),
+                     output.getWritePointer(channel), numSamples);
+
+    writeFrame = (writeFrame + numSamples) % numFrames;
+    numWritten = juce::jmin(numFrames, numWritten + numSamples);
+  }
+
+  processing.store(false);
+}
+
+void MultibandDelay::processChannel(float *buffer, int channel,
+                                    const float *input, float *output,
+                                    int numSamples) noexcept {
+  auto &channelStates = states[size_t(channel)];
+
+  // Filter state stays in registers for the whole block
+  Vec s1[maxSections], s2[maxSections];
+  for (int i = 0; i < numSections; ++i) {
+    s1[i] = load(channelStates[size_t(i)].s1);
+    s2[i] = load(channelStates[size_t(i)].s2);
+  }
+
+  // Every channel runs the same glide and ramps from the same start values
+  Vec delay = load(delays);
+  Vec targetDelay = load(targetDelays);
+  Vec smoothing = set(coeff);
+
+  Vec rampStep = set(1.0f / float(numSamples));
+  Vec feedback = load(feedbacks);
+  Vec feedbackStep = mul(sub(load(targetFeedbacks), feedback), rampStep);
+  Vec level = load(levels);
+  Vec levelStep = mul(sub(load(targetLevels), level), rampStep);
+
+  float maxDelay = float(numFrames - 2);
+  float *lanes = buffer + channel * numLanes;
+  int frame = writeFrame;
+  int written = numWritten;
+
+  alignas(16) float laneDelays[numLanes];
+  alignas(16) float delayed[numLanes]{};
+  alignas(16) float weighted[numLanes];
+
+  for (int sample = 0; sample < numSamples; ++sample) {
+    // Crossover, transposed direct form II biquads on all bands at once
+    Vec x = set(input[sample]);
+
+    for (int i = 0; i < numSections; ++i) {
+      const auto &c = coefficients[size_t(i)];
+
+      Vec y = add(mul(load(c.b0), x), s1[i]);
+      s1[i] = add(sub(mul(load(c.b1), x), mul(load(c.a1), y)), s2[i]);
+      s2[i] = sub(mul(load(c.b2), x), mul(load(c.a2), y));
+      x = y;
+    }
+
+    delay = add(delay, mul(sub(targetDelay, delay), smoothing));
+    feedback = add(feedback, feedbackStep);
+    level = add(level, levelStep);
+
+    /*
+     Each band reads at its own delay, the write happens after the read
+     so the shortest delay is one sample. Frames older than what was
+     written since reset() still hold stale data and read as silence.
+    */
+    store(laneDelays, delay);
+
+    for (int lane = 0; lane < numBands; ++lane) {
+      float laneDelay = juce::jlimit(1.0f, maxDelay, laneDelays[lane]);
+      int age = int(laneDelay);
+      float frac = laneDelay - float(age);
+
+      int index1 = frame - age;
+      if (index1 < 0)
+        index1 += numFrames;
+      int index2 = index1 == 0 ? numFrames - 1 : index1 - 1;
+
+      float value1 = age <= written ? lanes[index1 * frameSize + lane] : 0.0f;
+      float value2 =
+          age < written ? lanes[index2 * frameSize + lane] : 0.0f;
+
+      delayed[lane] = value1 + frac * (value2 - value1);
+    }
+
+    Vec out = load(delayed);
+    store(lanes + frame * frameSize, add(x, mul(feedback, out)));
+
+    store(weighted, mul(level, out));
+    output[sample] = (weighted[0] + weighted[1]) + (weighted[2] + weighted[3]);
+
+    if (++frame == numFrames)
+      frame = 0;
+    if (written < numFrames)
+      ++written;
+  }
+
+  for (int i = 0; i < numSections; ++i) {
+    store(channelStates[size_t(i)].s1, s1[i]);
+    store(channelStates[size_t(i)].s2, s2[i]);
+  }
+
+  // Last channel hands the glide and ramp positions on to the next block
+  if (channel == numChannels - 1) {
+    store(delays, delay);
+    std::copy(std::begin(targetFeedbacks), std::end(targetFeedbacks),
+              feedbacks);
+    std::copy(std::begin(targetLevels), std::end(targetLevels), levels);
+  }
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    MultibandDelay.h
+    Created: 19 Oct 2026 10:41:08pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayMemoryPool.h"
+#include "Parameters.h"
+#include <JuceHeader.h>
+
+/*
+ Delay that splits the input into 2 to 4 bands with Linkwitz-Riley
+ crossovers, every band with its own delay time, feedback and level.
+
+ Each band is one lane of a four-lane vector, so the crossover filters
+ of all bands run as a single SIMD filter. For this every band gets the
+ same chain of one LR4 section per crossover, a lowpass, highpass or
+ allpass depending on which side of that crossover the band sits:
+
+               crossover 1   crossover 2   crossover 3
+      band 1 :     LP            AP            AP
+      band 2 :     HP            LP            AP
+      band 3 :     HP            HP            LP
+      band 4 :     HP            HP            HP
+
+ The allpasses give the lower bands the phase shift of the crossovers
+ above them, so the bands still add up to an allpass of the input.
+
+ All bands write into one buffer interleaved by channel and band, one
+ frame per sample holds [L1 L2 L3 L4 R1 R2 R3 R4]. Feedback stays
+ inside its band, the delayed band signal is mixed back into the band
+ input before it is written.
+
+ The buffer is 8 times the size of a single delay line, so it is only
+ taken from the pool while the multiband delay is switched on. setEnabled
+ acquires or releases it off the audio thread and publishes it through an
+ atomic pointer. Until it arrives the output is silent.
+*/
+class MultibandDelay {
+public:
+  MultibandDelay() = default;
+  ~MultibandDelay();
+
+  void prepareToPlay(double sampleRate, int maxDelayInSamples);
+
+  // Not on the audio thread, releasing waits for a block in progress
+  void setEnabled(bool shouldBeEnabled);
+  void releaseMemory() noexcept;
+
+  // Clears the filters and, lazily, the buffer
+  void reset() noexcept;
+
+  // Called once per block before process
+  void setBands(int numBands,
+                const std::array<float, Parameters::maxBands - 1>
+                    &crossoverFrequencies) noexcept;
+  void setBandParameters(
+      const std::array<float, Parameters::maxBands> &delayTimesInSamples,
+      const std::array<float, Parameters::maxBands> &feedbacks,
+      const std::array<float, Parameters::maxBands> &levels) noexcept;
+
+  // Reads the dry input and writes the summed band outputs
+  void process(const juce::AudioBuffer<float> &input,
+               juce::AudioBuffer<float> &output, int numSamples) noexcept;
+
+  static constexpr int numLanes = 4;
+  static constexpr int numChannels = 2;
+  static constexpr int frameSize = numLanes * numChannels;
+
+  static_assert(Parameters::maxBands == numLanes,
+                "one band per lane of the SIMD filter");
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultibandDelay)
+
+  // Two biquads make one LR4 section, one section per crossover
+  static constexpr int maxSections = 2 * (numLanes - 1);
+
+  // Biquad coefficients, one value per lane
+  struct Coefficients {
+    alignas(16) float b0[numLanes];
+    alignas(16) float b1[numLanes];
+    alignas(16) float b2[numLanes];
+    alignas(16) float a1[numLanes];
+    alignas(16) float a2[numLanes];
+  };
+
+  // Transposed direct form II state, one value per lane
+  struct State {
+    alignas(16) float s1[numLanes];
+    alignas(16) float s2[numLanes];
+  };
+
+  void updateCoefficients() noexcept;
+  void processChannel(float *buffer, int channel, const float *input,
+                      float *output, int numSamples) noexcept;
+
+  juce::SharedResourcePointer<DelayMemoryPool> pool;
+  int numFrames = 0;
+
+  // Published off the audio thread. The audio thread flags the blocks it
+  // uses the buffer in, so it is only released once no block can see it.
+  std::atomic<float *> memory{nullptr};
+  std::atomic<bool> processing{false};
+
+  // Buffer the last block used, a different one starts empty
+  float *usedMemory = nullptr;
+
+  // Frame the next sample is written to, frames behind it are older
+  int writeFrame = 0;
+
+  // Frames written since reset(), older ones read as silence
+  int numWritten = 0;
+
+  std::array<Coefficients, maxSections> coefficients;
+  std::array<std::array<State, maxSections>, numChannels> states;
+
+  int numBands = 1;
+  int numSections = 0;
+  std::array<float, numLanes - 1> crossovers{};
+
+  // Delay times glide like the single band delay, level and feedback are
+  // ramped linearly across each block
+  alignas(16) float delays[numLanes]{};
+  alignas(16) float targetDelays[numLanes]{};
+  alignas(16) float feedbacks[numLanes]{};
+  alignas(16) float targetFeedbacks[numLanes]{};
+  alignas(16) float levels[numLanes]{};
+  alignas(16) float targetLevels[numLanes]{};
+  bool primed = false;
+
+  double preparedSampleRate = 0.0;
+  float coeff = 0.0f;
+};
@@ -9,6 +9,7 @@
 */
 
 #include "Parameters.h"
+#include "FastMath.h"
 
 template <typename T>
 
@@ -44,14 +45,74 @@ static float millisecondsFromString(const juce::String &text) {
   return value;
 }
 
+static juce::String stringFromSeconds(float value, int) {
+  if (value < 60.0f)
+    return juce::String(value, 1) + " s";
+
+  int seconds = juce::roundToInt(value);
+  return juce::String(seconds / 60) + ":" +
+         juce::String(seconds % 60).paddedLeft('0', 2) + " min";
+}
+
+// Takes seconds, or minutes as "m:ss" or with "min"
+static float secondsFromString(const juce::String &text) {
+  if (text.containsChar(':'))
+    return text.upToFirstOccurrenceOf(":", false, false).getFloatValue() *
+               60.0f +
+           text.fromFirstOccurrenceOf(":", false, false).getFloatValue();
+
+  float value = text.getFloatValue();
+
+  if (text.endsWithIgnoreCase("min") || text.endsWithIgnoreCase("m"))
+    return value * 60.0f;
+
+  return value;
+}
+
 static juce::String stringFromPercent(float value, int) {
   return juce::String(int(value)) + " %";
 }
 
+static juce::String stringFromHz(float value, int) {
+  if (value < 1000.0f)
+    return juce::String(int(value)) + " Hz";
+  else
+    return juce::String(value * 0.001f, 1) + " kHz";
+}
+
+static float hzFromString(const juce::String &text) {
+  float value = text.getFloatValue();
+
+  if (text.endsWithIgnoreCase("kHz") || value < 20.0f)
+    return value * 1000.0f;
+
+  return value;
+}
+
 Parameters::Parameters(juce::AudioProcessorValueTreeState &apvts) {
   castParameter(apvts, gainParamID, gainParam);
   castParameter(apvts, delayTimeParamID, delayTimeParam);
   castParameter(apvts, mixParamID, mixParam);
+  castParameter(apvts, delayModeParamID, delayModeParam);
+  castParameter(apvts, midiDelayTimeParamID, midiDelayTimeParam);
+  castParameter(apvts, duckThresholdParamID, duckThresholdParam);
+  castParameter(apvts, duckAmountParamID, duckAmountParam);
+  castParameter(apvts, freezeParamID, freezeParam);
+  castParameter(apvts, diffusionParamID, diffusionParam);
+  castParameter(apvts, spaceParamID, spaceParam);
+  castParameter(apvts, spaceMixParamID, spaceMixParam);
+  castParameter(apvts, longDelayParamID, longDelayParam);
+  castParameter(apvts, longDelayTimeParamID, longDelayTimeParam);
+  castParameter(apvts, bandCountParamID, bandCountParam);
+
+  for (size_t i = 0; i < crossoverParams.size(); ++i)
+    castParameter(apvts, crossoverParamIDs[i], crossoverParams[i]);
+
+  for (size_t i = 0; i < size_t(maxBands); ++i) {
+    castParameter(apvts, bandDelayTimeParamIDs[i], bandDelayTimeParams[i]);
+    castParameter(apvts, bandFeedbackParamIDs[i], bandFeedbackParams[i]);
+    castParameter(apvts, bandLevelParamIDs[i], bandLevelParams[i]);
+  }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -80,10 +141,110 @@ Parameters::createParameterLayout() {
       juce::AudioParameterFloatAttributes().withStringFromValueFunction(
           stringFromPercent)));
 
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      delayModeParamID, "Delay Mode",
+      juce::StringArray{"Glide", "Crossfade"}, 0));
+
+  layout.add(std::make_unique<juce::AudioParameterBool>(
+      midiDelayTimeParamID, "MIDI Delay Time", false));
+
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      duckThresholdParamID, "Duck Threshold",
+      juce::NormalisableRange<float>{-60.0f, 0.0f}, -30.0f,
+      juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+          stringFromDecibels)));
+
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      duckAmountParamID, "Duck Amount",
+      juce::NormalisableRange<float>{0.0f, 100.0f, 1.0f}, 0.0f,
+      juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+          stringFromPercent)));
+
+  layout.add(std::make_unique<juce::AudioParameterBool>(freezeParamID,
+                                                        "Freeze", false));
+
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      diffusionParamID, "Diffusion",
+      juce::NormalisableRange<float>{0.0f, 100.0f, 1.0f}, 0.0f,
+      juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+          stringFromPercent)));
+
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      spaceParamID, "Space",
+      juce::StringArray{"Off", "Tape Head", "Spring", "Small Room"}, 0));
+
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      spaceMixParamID, "Space Mix",
+      juce::NormalisableRange<float>{0.0f, 100.0f, 1.0f}, 50.0f,
+      juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+          stringFromPercent)));
+
+  layout.add(std::make_unique<juce::AudioParameterBool>(
+      longDelayParamID, "Long Delay", false));
+
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      longDelayTimeParamID, "Long Delay Time",
+      juce::NormalisableRange<float>{minLongDelayTime, maxLongDelayTime, 0.1f,
+                                     0.3f},
+      30.0f,
+      juce::AudioParameterFloatAttributes()
+          .withStringFromValueFunction(stringFromSeconds)
+          .withValueFromStringFunction(secondsFromString)));
+
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      bandCountParamID, "Bands",
+      juce::StringArray{"Off", "2 Bands", "3 Bands", "4 Bands"}, 0));
+
+  // Ranges overlap, update() keeps the frequencies in ascending order
+  const float crossoverDefaults[]{250.0f, 1500.0f, 6000.0f};
+
+  for (size_t i = 0; i < crossoverParamIDs.size(); ++i) {
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        crossoverParamIDs[i], "Crossover " + juce::String(int(i) + 1),
+        juce::NormalisableRange<float>{20.0f, 20000.0f, 1.0f, 0.25f},
+        crossoverDefaults[i],
+        juce::AudioParameterFloatAttributes()
+            .withStringFromValueFunction(stringFromHz)
+            .withValueFromStringFunction(hzFromString)));
+  }
+
+  for (size_t i = 0; i < size_t(maxBands); ++i) {
+    juce::String band = "Band " + juce::String(int(i) + 1);
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        bandDelayTimeParamIDs[i], band + " Delay Time",
+        juce::NormalisableRange<float>{minDelayTime, maxDelayTime, 0.001f,
+                                       0.25f},
+        125.0f * float(i + 1),
+        juce::AudioParameterFloatAttributes()
+            .withStringFromValueFunction(stringFromMilliseconds)
+            .withValueFromStringFunction(millisecondsFromString)));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        bandFeedbackParamIDs[i], band + " Feedback",
+        juce::NormalisableRange<float>{0.0f, maxBandFeedback * 100.0f, 1.0f},
+        30.0f,
+        juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+            stringFromPercent)));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        bandLevelParamIDs[i], band + " Level",
+        juce::NormalisableRange<float>{0.0f, 100.0f, 1.0f}, 100.0f,
+        juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+            stringFromPercent)));
+  }
+
   return layout;
 }
 
 void Parameters::prepareToPlay(double sampleRate) noexcept {
+  // Hosts call prepareToPlay on every transport or device change, nothing
+  // below depends on anything but the sample rate
+  if (sampleRate == preparedSampleRate)
+    return;
+
+  preparedSampleRate = sampleRate;
+
   /*
    The ramp length value is crucial here!!
       - Too short : The wave amplitude jumps with sudden spikes,
@@ -99,7 +260,8 @@ void Parameters::prepareToPlay(double sampleRate) noexcept {
   double rampLengthInSeconds = 0.02;
   gainSmoother.reset(sampleRate, rampLengthInSeconds);
 
-  // Coefficient calculation for one-pole filter smoothing in delay
+  // Coefficient calculation for one-pole filter smoothing in delay.
+  // Stays with std::exp, see FastMath.h.
   coeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
 
   mixSmoother.reset(sampleRate, rampLengthInSeconds);
@@ -108,8 +270,7 @@ void Parameters::prepareToPlay(double sampleRate) noexcept {
 void Parameters::reset() noexcept {
   gain = 0.0f;
 
-  gainSmoother.setCurrentAndTargetValue(
-      juce::Decibels::decibelsToGain(gainParam->get()));
+  gainSmoother.setCurrentAndTargetValue(FastMath::dbToGain(gainParam->get()));
 
   delayTime = 0.0f;
 
@@ -118,20 +279,56 @@ void Parameters::reset() noexcept {
 }
 
 void Parameters::update() noexcept {
-  gainSmoother.setTargetValue(juce::Decibels::decibelsToGain(gainParam->get()));
+  gainSmoother.setTargetValue(FastMath::dbToGain(gainParam->get()));
 
   targetDelayTime = delayTimeParam->get();
   if (delayTime == 0.0f)
     delayTime = targetDelayTime;
 
+  delayMode = DelayMode(delayModeParam->getIndex());
+  midiDelayTime = midiDelayTimeParam->get();
+
   mixSmoother.setTargetValue(mixParam->get() * 0.01f);
+
+  duckThreshold = FastMath::dbToGain(duckThresholdParam->get());
+  duckAmount = duckAmountParam->get() * 0.01f;
+
+  freeze = freezeParam->get();
+
+  diffusion = diffusionParam->get() * 0.01f;
+
+  space = spaceParam->getIndex();
+  spaceMix = spaceMixParam->get() * 0.01f;
+
+  longDelay = longDelayParam->get();
+  longDelayTime = longDelayTimeParam->get();
+
+  numBands = bandCountParam->getIndex() + 1;
+
+  float previous = 0.0f;
+  for (size_t i = 0; i < crossoverParams.size(); ++i) {
+    previous = juce::jmax(previous, crossoverParams[i]->get());
+    crossoverFrequencies[i] = previous;
+  }
+
+  for (size_t i = 0; i < size_t(maxBands); ++i) {
+    bandDelayTimes[i] = bandDelayTimeParams[i]->get();
+    bandFeedbacks[i] = bandFeedbackParams[i]->get() * 0.01f;
+    bandLevels[i] = bandLevelParams[i]->get() * 0.01f;
+  }
 }
 
 void Parameters::smoothen() noexcept {
   gain = gainSmoother.getNextValue();
 
-  // delay = delay * (1 - coeff) + target * coeff
-  delayTime += (targetDelayTime - delayTime) * coeff;
-
   mix = mixSmoother.getNextValue();
 }
+
+void Parameters::smoothenDelayTime() noexcept {
+  // delay = delay * (1 - coeff) + target * coeff
+  // In crossfade mode the time jumps, the fade in processBlock hides the jump
+  if (delayMode == DelayMode::GLIDE)
+    delayTime += (targetDelayTime - delayTime) * coeff;
+  else
+    delayTime = targetDelayTime;
+}
@@ -15,6 +15,42 @@
 const juce::ParameterID gainParamID{"gain", 1};
 const juce::ParameterID delayTimeParamID{"delayTime", 1};
 const juce::ParameterID mixParamID{"mix", 1};
+const juce::ParameterID delayModeParamID{"delayMode", 1};
+const juce::ParameterID duckThresholdParamID{"duckThreshold", 1};
+const juce::ParameterID duckAmountParamID{"duckAmount", 1};
+const juce::ParameterID freezeParamID{"freeze", 1};
+const juce::ParameterID diffusionParamID{"diffusion", 1};
+const juce::ParameterID bandCountParamID{"bandCount", 1};
+const juce::ParameterID midiDelayTimeParamID{"midiDelayTime", 1};
+const juce::ParameterID spaceParamID{"space", 1};
+const juce::ParameterID spaceMixParamID{"spaceMix", 1};
+const juce::ParameterID longDelayParamID{"longDelay", 1};
+const juce::ParameterID longDelayTimeParamID{"longDelayTime", 1};
+
+const std::array<juce::ParameterID, 3> crossoverParamIDs{
+    juce::ParameterID{"crossover1", 1}, juce::ParameterID{"crossover2", 1},
+    juce::ParameterID{"crossover3", 1}};
+
+const std::array<juce::ParameterID, 4> bandDelayTimeParamIDs{
+    juce::ParameterID{"bandDelayTime1", 1},
+    juce::ParameterID{"bandDelayTime2", 1},
+    juce::ParameterID{"bandDelayTime3", 1},
+    juce::ParameterID{"bandDelayTime4", 1}};
+
+const std::array<juce::ParameterID, 4> bandFeedbackParamIDs{
+    juce::ParameterID{"bandFeedback1", 1},
+    juce::ParameterID{"bandFeedback2", 1},
+    juce::ParameterID{"bandFeedback3", 1},
+    juce::ParameterID{"bandFeedback4", 1}};
+
+const std::array<juce::ParameterID, 4> bandLevelParamIDs{
+    juce::ParameterID{"bandLevel1", 1}, juce::ParameterID{"bandLevel2", 1},
+    juce::ParameterID{"bandLevel3", 1}, juce::ParameterID{"bandLevel4", 1}};
+
+// How a change in delay time is applied to the delay line
+//    GLIDE : one-pole smoothing of the time, tape-like pitch warble
+//    CROSSFADE : jump to the new time with a short equal-power crossfade
+enum class DelayMode { GLIDE, CROSSFADE };
 
 class Parameters {
 public:
@@ -26,7 +62,11 @@ public:
   void prepareToPlay(double sampleRate) noexcept;
   void reset() noexcept;
   void update() noexcept;
+
+  // Per sample smoothing, output gain and mix in smoothen() and the delay
+  // time separately since processBlock reads the delay line in its own pass
   void smoothen() noexcept;
+  void smoothenDelayTime() noexcept;
 
   float gain = 0.0f;
 
@@ -39,9 +79,56 @@ public:
   float targetDelayTime = 0.0f;
   float coeff = 0.0f;
 
+  DelayMode delayMode = DelayMode::GLIDE;
+
+  // Delay time follows MIDI notes, clock and tap tempo, see MidiDelayTime
+  bool midiDelayTime = false;
+
   // Mix for dry and wet samples from delay line
   float mix = 1.0f;
 
+  // Ducking of the wet signal, threshold as linear gain and amount 0 to 1.
+  // An amount of 0 switches the ducker off.
+  float duckThreshold = 1.0f;
+  float duckAmount = 0.0f;
+
+  // Holds the delay line contents as an endless loop
+  bool freeze = false;
+
+  // Allpass diffusion on the wet signal, 0 to 1
+  float diffusion = 0.0f;
+
+  // Convolution on the wet signal, 0 is off, otherwise a
+  // SpaceImpulses::Type. Mix goes from 0 to 1.
+  int space = 0;
+  float spaceMix = 0.0f;
+
+  /*
+   Long delay, a file-backed buffer for delays and loops of minutes, see
+   LongDelayLine. Its time is in seconds and replaces the delay time
+   parameter while long delay is on.
+  */
+  static constexpr float minLongDelayTime = 5.0f;
+  static constexpr float maxLongDelayTime = 600.0f;
+
+  bool longDelay = false;
+  float longDelayTime = 0.0f;
+
+  /*
+   Multiband delay, 1 band means off and the single delay line above is
+   used. Crossover frequencies in Hz, ascending, only the first
+   numBands - 1 of them are used. Band delay times in milliseconds,
+   feedback and level 0 to 1.
+  */
+  static constexpr int maxBands = 4;
+  static constexpr float maxBandFeedback = 0.95f;
+
+  int numBands = 1;
+  std::array<float, maxBands - 1> crossoverFrequencies{};
+  std::array<float, maxBands> bandDelayTimes{};
+  std::array<float, maxBands> bandFeedbacks{};
+  std::array<float, maxBands> bandLevels{};
+
 private:
   /*
    Below is a macro that is used for two purposes
@@ -54,11 +141,35 @@ private:
   */
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Parameters)
 
+  // Sample rate the ramps and coeff were last computed for
+  double preparedSampleRate = 0.0;
+
   juce::AudioParameterFloat *gainParam;
   juce::LinearSmoothedValue<float> gainSmoother;
 
   juce::AudioParameterFloat *delayTimeParam;
+  juce::AudioParameterChoice *delayModeParam;
+  juce::AudioParameterBool *midiDelayTimeParam;
 
   juce::AudioParameterFloat *mixParam;
   juce::LinearSmoothedValue<float> mixSmoother;
+
+  juce::AudioParameterFloat *duckThresholdParam;
+  juce::AudioParameterFloat *duckAmountParam;
+
+  juce::AudioParameterBool *freezeParam;
+
+  juce::AudioParameterFloat *diffusionParam;
+
+  juce::AudioParameterChoice *spaceParam;
+  juce::AudioParameterFloat *spaceMixParam;
+
+  juce::AudioParameterBool *longDelayParam;
+  juce::AudioParameterFloat *longDelayTimeParam;
+
+  juce::AudioParameterChoice *bandCountParam;
+  std::array<juce::AudioParameterFloat *, maxBands - 1> crossoverParams;
+  std::array<juce::AudioParameterFloat *, maxBands> bandDelayTimeParams;
+  std::array<juce::AudioParameterFloat *, maxBands> bandFeedbackParams;
+  std::array<juce::AudioParameterFloat *, maxBands> bandLevelParams;
 };
@@ -31,7 +31,7 @@ A0LearnDelayAudioProcessorEditor::A0LearnDelayAudioProcessorEditor(
   outputGroup.addAndMakeVisible(gainKnob);
   addAndMakeVisible(outputGroup);
 
-  setLookAndFeel(&mainLF);
+  setLookAndFeel(&resources->mainLF);
 
   setSize(500, 330);
 }
@@ -44,9 +44,8 @@ A0LearnDelayAudioProcessorEditor::~A0LearnDelayAudioProcessorEditor() {
 void A0LearnDelayAudioProcessorEditor::paint(juce::Graphics &g) {
   // (Our component is opaque, so we must completely fill the background with a
   // solid colour) g.fillAll(Colors::background);
-  auto noise = juce::ImageCache::getFromMemory(BinaryData::Noise_png,
-                                               BinaryData::Noise_pngSize);
-  auto fillType = juce::FillType(noise, juce::AffineTransform::scale(0.5f));
+  auto fillType =
+      juce::FillType(resources->noise, juce::AffineTransform::scale(0.5f));
   g.setFillType(fillType);
   g.fillRect(getLocalBounds());
 
@@ -54,8 +53,7 @@ void A0LearnDelayAudioProcessorEditor::paint(juce::Graphics &g) {
   g.setColour(Colors::header);
   g.fillRect(rect);
 
-  auto image = juce::ImageCache::getFromMemory(BinaryData::Logo_png,
-                                               BinaryData::Logo_pngSize);
+  const auto &image = resources->logo;
 
   // Image is actually twice as big as needed in the UI
   int destWidth = image.getWidth() / 2;
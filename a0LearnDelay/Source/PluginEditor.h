@@ -43,5 +43,6 @@ private:
   RotaryKnob delayTimeKnob{"Delay Time", audioProcessor.apvts,
                            delayTimeParamID};
 
-  MainLookAndFeel mainLF;
+  // Fonts, images and look and feels, created with the first editor
+  juce::SharedResourcePointer<EditorResources> resources;
 };
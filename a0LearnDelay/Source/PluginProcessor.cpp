@@ -16,10 +16,19 @@ A0LearnDelayAudioProcessor::A0LearnDelayAudioProcessor()
     : juce::AudioProcessor(
           BusesProperties()
               .withInput("Input", juce::AudioChannelSet::stereo(), true)
-              .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      params(apvts) {}
+              .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+              .withInput("Sidechain", juce::AudioChannelSet::stereo(),
+                         false)),
+      params(apvts) {
+  for (const auto &parameterID : resourceParamIDs)
+    apvts.addParameterListener(parameterID.getParamID(), this);
+}
 
-A0LearnDelayAudioProcessor::~A0LearnDelayAudioProcessor() {}
+A0LearnDelayAudioProcessor::~A0LearnDelayAudioProcessor() {
+  for (const auto &parameterID : resourceParamIDs)
+    apvts.removeParameterListener(parameterID.getParamID(), this);
+  cancelPendingUpdate();
+}
 
 //==============================================================================
 const juce::String A0LearnDelayAudioProcessor::getName() const {
@@ -50,7 +59,44 @@ bool A0LearnDelayAudioProcessor::isMidiEffect() const {
 #endif
 }
 
-double A0LearnDelayAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double A0LearnDelayAudioProcessor::getTailLengthSeconds() const {
+  // Straight from the parameters, params is the audio thread's copy
+  auto value = [this](const juce::ParameterID &parameterID) {
+    return double(apvts.getRawParameterValue(parameterID.getParamID())->load());
+  };
+
+  bool freeze = value(freezeParamID) > 0.5;
+  int numBands = int(value(bandCountParamID)) + 1;
+  double tail = 0.0;
+
+  if (numBands > 1) {
+    // Every band repeats until its feedback has brought it down by 60 dB
+    for (size_t i = 0; i < size_t(numBands); ++i) {
+      double feedback = value(bandFeedbackParamIDs[i]) * 0.01;
+      double repeats = 1.0;
+      if (feedback > 0.0)
+        repeats += std::log(0.001) / std::log(feedback);
+
+      tail = std::max(tail, repeats * value(bandDelayTimeParamIDs[i]) / 1000.0);
+    }
+  } else if (freeze) {
+    // The loop plays until freeze is switched off
+    return std::numeric_limits<double>::infinity();
+  } else if (value(longDelayParamID) > 0.5) {
+    tail = value(longDelayTimeParamID);
+  } else {
+    // MIDI can set any delay time
+    tail = value(midiDelayTimeParamID) > 0.5 ? Parameters::maxDelayTime
+                                             : value(delayTimeParamID);
+    tail /= 1000.0;
+  }
+
+  int space = int(value(spaceParamID));
+  if (space > 0)
+    tail += SpaceImpulses::getLengthInSeconds(SpaceImpulses::Type(space));
+
+  return tail;
+}
 
 int A0LearnDelayAudioProcessor::getNumPrograms() {
   return 1; // NB: some hosts don't cope very well if you tell them there are 0
@@ -74,6 +120,21 @@ void A0LearnDelayAudioProcessor::prepareToPlay(double sampleRate,
                                                int samplesPerBlock) {
   // Use this method as the place to do any pre-playback
   // initialisation that you need..
+  const juce::ScopedLock lock(resourceLock);
+
+  /*
+   Re-preparation is incremental. Each part below only redoes work when
+   the setting it depends on has changed:
+      - Sample rate : smoothing ramps and coeff, crossfade table,
+                      ducker coefficients, delay buffer size,
+                      convolution kernels, long delay file
+      - Channel count : delay buffer
+      - Block size : ducker gain and wet buffers, only when they grow
+
+   What is always done is resetting the running state, which is cheap
+   since the delay line clears its buffer lazily. The multiband buffer is
+   only taken by updateResources, and only while multiband is on.
+  */
   params.prepareToPlay(sampleRate);
   params.reset();
 
@@ -87,12 +148,75 @@ void A0LearnDelayAudioProcessor::prepareToPlay(double sampleRate,
   double numSamples = (Parameters::maxDelayTime / 1000.0) * sampleRate;
   int maxDelayInSamples = int(std::ceil(numSamples));
   delayLine.setMaximumDelayInSamples(maxDelayInSamples);
-  delayLine.reset();
+
+  crossfade.prepareToPlay(sampleRate);
+
+  looper.prepareToPlay(sampleRate);
+
+  midiDelayTime.prepareToPlay(sampleRate);
+
+  diffuser.prepareToPlay(sampleRate, samplesPerBlock);
+
+  space.prepareToPlay(sampleRate);
+
+  multibandDelay.prepareToPlay(sampleRate, maxDelayInSamples);
+
+  longDelayLine.prepareToPlay(sampleRate, Parameters::maxLongDelayTime);
+
+  // Only grows, a smaller block size keeps the existing buffer
+  wetBuffer.setSize(2, samplesPerBlock, false, false, true);
+
+  ducker.prepareToPlay(sampleRate, samplesPerBlock);
+
+  prepared = true;
+  updateResources();
 }
 
 void A0LearnDelayAudioProcessor::releaseResources() {
   // When playback stops, you can use this as an opportunity to free up any
   // spare memory, etc.
+  const juce::ScopedLock lock(resourceLock);
+  prepared = false;
+
+  // Delay buffer goes back to the shared pool for other instances to reuse
+  delayLine.releaseMemory();
+  diffuser.releaseMemory();
+  multibandDelay.releaseMemory();
+
+  // Stops the convolution worker thread
+  space.releaseResources();
+
+  // Stops the residency thread and deletes the long delay file
+  longDelayLine.releaseResources();
+}
+
+void A0LearnDelayAudioProcessor::parameterChanged(const juce::String &,
+                                                  float) {
+  // May be called on the audio thread, the update happens on the message
+  // thread
+  triggerAsyncUpdate();
+}
+
+void A0LearnDelayAudioProcessor::handleAsyncUpdate() { updateResources(); }
+
+void A0LearnDelayAudioProcessor::updateResources() {
+  const juce::ScopedLock lock(resourceLock);
+  if (!prepared)
+    return;
+
+  auto value = [this](const juce::ParameterID &parameterID) {
+    return apvts.getRawParameterValue(parameterID.getParamID())->load();
+  };
+
+  // Multiband delay buffer, 8 times the size of the single delay line
+  bool multiband = int(value(bandCountParamID)) > 0;
+  multibandDelay.setEnabled(multiband);
+
+  // Residency thread and file, multiband wins over long delay
+  longDelayLine.setEnabled(!multiband && value(longDelayParamID) > 0.5f);
+
+  // Convolution worker
+  space.setEnabled(int(value(spaceParamID)) > 0);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -116,6 +240,13 @@ bool A0LearnDelayAudioProcessor::isBusesLayoutSupported(
     return false;
 #endif
 
+  // Optional sidechain for ducking, mono or stereo when enabled
+  auto sidechain = layouts.getChannelSet(true, 1);
+  if (!sidechain.isDisabled() &&
+      sidechain != juce::AudioChannelSet::mono() &&
+      sidechain != juce::AudioChannelSet::stereo())
+    return false;
+
   return true;
 #endif
 }
@@ -123,7 +254,7 @@ bool A0LearnDelayAudioProcessor::isBusesLayoutSupported(
 
 void A0LearnDelayAudioProcessor::processBlock(
     juce::AudioBuffer<float> &buffer,
-    [[maybe_unused]] juce::MidiBuffer &midiMessages) {
+    juce::MidiBuffer &midiMessages) {
   // DeNormals are values below lowerst floating point. This ensures that
   // float is approximated to zero at values < 10^(-38) and does not lead
   // to sudden CPU usage spike.
@@ -157,8 +288,41 @@ void A0LearnDelayAudioProcessor::processBlock(
 
   params.update();
 
+  /*
+   MIDI is parsed every block, so the clock tempo and the taps are
+   tracked even while MIDI delay time is off. Once a note, beat or tap
+   has come in, its time replaces the delay time parameter.
+  */
+  if (params.midiDelayTime && midiDelayTime.hasDelayTime())
+    params.targetDelayTime = midiDelayTime.getDelayTime();
+
+  midiDelayTime.parse(midiMessages, buffer.getNumSamples());
+
+  // Offline nothing has to be real-time safe, resources are updated here
+  if (isNonRealtime())
+    updateResources();
+
   float sampleRate = float(getSampleRate());
 
+  /*
+   Ducking gains are computed for the whole block up front, while the
+   buffer still holds the dry input. The sidechain is used as the key
+   when the host has connected one. Switched off, the ducker keeps running
+   until its gain is back at unity.
+  */
+  const float *duckGains = nullptr;
+
+  if (params.duckAmount > 0.0f || ducker.isDucking()) {
+    bool hasSidechain = getChannelCountOfBus(true, 1) > 0;
+    auto key = getBusBuffer(buffer, true, hasSidechain ? 1 : 0);
+
+    ducker.process(key, buffer.getNumSamples(), params.duckThreshold,
+                   params.duckAmount);
+    duckGains = ducker.getGains();
+  } else {
+    ducker.reset();
+  }
+
   gainImplementationChoice choice = gainImplementationChoice::CUSTOM;
 
   if (choice == gainImplementationChoice::PRE_BUILT) {
@@ -166,10 +330,130 @@ void A0LearnDelayAudioProcessor::processBlock(
     buffer.applyGain(params.gain);
   } else if (choice == gainImplementationChoice::CUSTOM) {
     // Gain method 2 : Custom function
+    int numSamples = buffer.getNumSamples();
+
     float *channelDataL = buffer.getWritePointer(0);
     float *channelDataR = buffer.getWritePointer(1);
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
+    float *wetDataL = wetBuffer.getWritePointer(0);
+    float *wetDataR = wetBuffer.getWritePointer(1);
+
+    /*
+     Switching between the single, the multiband and the long delay
+     starts the one taking over from silence, its buffer is cleared
+     lazily. Multiband wins over long delay when both are on.
+    */
+    DelayPath path = params.numBands > 1 ? DelayPath::MULTIBAND
+                     : params.longDelay  ? DelayPath::LONG
+                                         : DelayPath::SINGLE;
+
+    if (path != delayPath) {
+      delayPath = path;
+
+      delayLine.reset();
+      crossfade.reset();
+      looper.reset();
+      multibandDelay.reset();
+      longDelayLine.reset();
+    }
+
+    /*
+     Plug-in : Delay
+
+     One-pole filter used for smoothing the delay time slider
+
+     The wet samples of the whole block are collected in wetBuffer
+     first, so the wet path effects after this can run per block.
+    */
+    if (delayPath == DelayPath::MULTIBAND) {
+      // Plug-in : Multiband delay, freeze and the delay mode do not apply
+      std::array<float, Parameters::maxBands> delayTimes;
+      for (size_t i = 0; i < delayTimes.size(); ++i)
+        delayTimes[i] = (params.bandDelayTimes[i] / 1000.0f) * sampleRate;
+
+      multibandDelay.setBands(params.numBands, params.crossoverFrequencies);
+      multibandDelay.setBandParameters(delayTimes, params.bandFeedbacks,
+                                       params.bandLevels);
+      multibandDelay.process(buffer, wetBuffer, numSamples);
+    } else if (delayPath == DelayPath::LONG) {
+      /*
+       Plug-in : Long delay, time changes crossfade and freeze loops the
+       file. MIDI delay time and the delay mode do not apply.
+      */
+      int delayInSamples =
+          int(std::round(params.longDelayTime * double(getSampleRate())));
+      longDelayLine.setNonRealtime(isNonRealtime());
+      longDelayLine.process(buffer, wetBuffer, numSamples, delayInSamples,
+                            params.freeze);
+    } else {
+      for (int sample = 0; sample < numSamples; ++sample) {
+        // Events of this block take effect at their own sample
+        float midiTime;
+        if (params.midiDelayTime &&
+            midiDelayTime.nextDelayTime(sample, midiTime))
+          params.targetDelayTime = midiTime;
+
+        /*
+         Switching delay modes carries on from the time the delay line
+         reads at. A crossfade that is running finishes first.
+        */
+        if (params.delayMode != delayMode && !crossfade.isFading())
+          switchDelayMode(sampleRate);
+
+        params.smoothenDelayTime();
+
+        float delayInSamples = (params.delayTime / 1000.0f) * sampleRate;
+
+        // Switched per sample so the loop starts exactly where the delay
+        // line output was
+        if (params.freeze != looper.isFreezing()) {
+          if (params.freeze)
+            looper.start(delayLine);
+          else
+            looper.stop();
+        }
+
+        float wetL, wetR;
+
+        if (looper.isFrozen()) {
+          /*
+           Freeze : the delay line is neither written nor read, the
+           loop plays straight out of its buffer
+          */
+          wetL = looper.readSample(0);
+          wetR = looper.readSample(1);
+          looper.advance();
+        } else {
+          delayLine.pushSample(0, channelDataL[sample]);
+          delayLine.pushSample(1, channelDataR[sample]);
+
+          readDelayLine(delayInSamples, wetL, wetR);
+
+          // Fading between the loop and the delay line after a freeze
+          if (looper.isReleasing()) {
+            float loopGain, delayGain;
+            looper.nextReleaseGains(loopGain, delayGain);
+
+            wetL = wetL * delayGain + looper.readSample(0) * loopGain;
+            wetR = wetR * delayGain + looper.readSample(1) * loopGain;
+            looper.advance();
+          }
+        }
+
+        wetDataL[sample] = wetL;
+        wetDataR[sample] = wetR;
+      }
+    }
+
+    // Plug-in : Diffusion, allpass chain smearing the echoes
+    diffuser.process(wetBuffer, numSamples, params.diffusion);
+
+    // Plug-in : Space, convolution with a tape head, spring or room
+    space.setSpace(params.space);
+    space.setNonRealtime(isNonRealtime());
+    space.process(wetBuffer, numSamples, params.spaceMix);
+
+    for (int sample = 0; sample < numSamples; ++sample) {
       /*
        Plug-in : Gain
 
@@ -178,30 +462,77 @@ void A0LearnDelayAudioProcessor::processBlock(
       */
       params.smoothen();
 
-      /*
-       Plug-in : Delay
+      // Dry and Wet samples are interfered for the final output
+      float wetGain = params.mix;
+      if (duckGains != nullptr)
+        wetGain *= duckGains[sample];
 
-       One-pole filter used for smoothing the delay time slider
+      float mixL = channelDataL[sample] + wetDataL[sample] * wetGain;
+      float mixR = channelDataR[sample] + wetDataR[sample] * wetGain;
 
-       Dry and Wet samples are interfered for ...
-      */
-      float delayInSamples = (params.delayTime / 1000.0f) * sampleRate;
-      delayLine.setDelay(delayInSamples);
+      channelDataL[sample] = mixL * params.gain;
+      channelDataR[sample] = mixR * params.gain;
+    }
+  }
+}
 
-      float dryL = channelDataL[sample];
-      float dryR = channelDataR[sample];
+void A0LearnDelayAudioProcessor::switchDelayMode(float sampleRate) noexcept {
+  delayMode = params.delayMode;
+  float delayInSamples = delayLine.getDelay();
 
-      delayLine.pushSample(0, dryL);
-      delayLine.pushSample(1, dryR);
+  if (delayMode == DelayMode::CROSSFADE) {
+    // Fades from here to the target instead of taking it as is
+    crossfade.setCurrentDelay(delayInSamples);
+  } else if (delayInSamples > 0.0f) {
+    // Glides from here instead of jumping back to the last glide position
+    params.delayTime = delayInSamples / sampleRate * 1000.0f;
+  }
+}
 
-      float wetL = delayLine.popSample(0);
-      float wetR = delayLine.popSample(1);
+void A0LearnDelayAudioProcessor::readDelayLine(float delayInSamples,
+                                               float &wetL,
+                                               float &wetR) noexcept {
+  if (delayMode == DelayMode::GLIDE) {
+    delayLine.setDelay(delayInSamples);
+
+    wetL = delayLine.popSample(0);
+    wetR = delayLine.popSample(1);
+  } else {
+    /*
+     Crossfade mode
+
+     The delay line is only touched with setDelay when the time
+     actually changes. A fade cannot be interrupted, any change
+     made during a fade is picked up once it has finished.
+    */
+    if (!crossfade.isFading() &&
+        delayInSamples != crossfade.getCurrentDelay()) {
+      if (!crossfade.start(delayInSamples))
+        delayLine.setDelay(delayInSamples);
+    }
 
-      float mixL = dryL + wetL * params.mix;
-      float mixR = dryR + wetR * params.mix;
+    if (crossfade.isFading()) {
+      // Incoming head is read first without moving the read pointer
+      float nextDelay = crossfade.getNextDelay();
+      float nextL = delayLine.popSample(0, nextDelay, false);
+      float nextR = delayLine.popSample(1, nextDelay, false);
 
-      channelDataL[sample] = mixL * params.gain;
-      channelDataR[sample] = mixR * params.gain;
+      float currentDelay = crossfade.getCurrentDelay();
+      float currentL = delayLine.popSample(0, currentDelay);
+      float currentR = delayLine.popSample(1, currentDelay);
+
+      float fadeOut, fadeIn;
+      crossfade.nextGains(fadeOut, fadeIn);
+
+      wetL = currentL * fadeOut + nextL * fadeIn;
+      wetR = currentR * fadeOut + nextR * fadeIn;
+
+      // Fade done, the delay line keeps the new time from now on
+      if (!crossfade.isFading())
+        delayLine.setDelay(nextDelay);
+    } else {
+      wetL = delayLine.popSample(0);
+      wetR = delayLine.popSample(1);
     }
   }
 }
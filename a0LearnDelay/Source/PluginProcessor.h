@@ -8,13 +8,25 @@
 
 #pragma once
 
+#include "DelayCrossfade.h"
+#include "Diffuser.h"
+#include "Ducker.h"
+#include "FreezeLooper.h"
+#include "LongDelayLine.h"
+#include "MidiDelayTime.h"
+#include "MultibandDelay.h"
 #include "Parameters.h"
+#include "PooledDelayLine.h"
+#include "SpaceConvolution.h"
 #include <JuceHeader.h>
 
 //==============================================================================
 /**
  */
-class A0LearnDelayAudioProcessor : public juce::AudioProcessor {
+class A0LearnDelayAudioProcessor
+    : public juce::AudioProcessor,
+      private juce::AudioProcessorValueTreeState::Listener,
+      private juce::AsyncUpdater {
 public:
   //==============================================================================
   A0LearnDelayAudioProcessor();
@@ -67,10 +79,71 @@ private:
   Parameters params;
 
   /*
-   This is a class template. Required arguments
-      - Samples data type
-      - Interpolationmethod for in-between/fractional samples
+   Same interface and linear interpolation as
+   juce::dsp::DelayLine<float, DelayLineInterpolationTypes::Linear>,
+   but the buffer is borrowed from the process-wide DelayMemoryPool
+   and given back in releaseResources.
   */
-  juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>
-      delayLine;
+  PooledDelayLine delayLine;
+
+  // Second read head used only while jumping in crossfade delay mode
+  DelayCrossfade crossfade;
+
+  // Wet signal ducking, keyed from the sidechain bus or the dry input
+  Ducker ducker;
+
+  FreezeLooper looper;
+
+  // Delay time from MIDI notes, clock and tap tempo
+  MidiDelayTime midiDelayTime;
+
+  Diffuser diffuser;
+
+  // Tape head, spring or room colour, the long tails on a worker thread
+  SpaceConvolution space;
+
+  // Takes over from the delay line above while more than one band is set
+  MultibandDelay multibandDelay;
+
+  // Takes over while long delay is on, buffer in a memory-mapped file
+  LongDelayLine longDelayLine;
+
+  // Which of the three delays fills the wet buffer
+  enum class DelayPath { SINGLE, MULTIBAND, LONG };
+  DelayPath delayPath = DelayPath::SINGLE;
+
+  // Delay line output for the current block, processed by the wet path
+  // effects before it is mixed with the dry signal
+  juce::AudioBuffer<float> wetBuffer;
+
+  // Reads one sample per channel from the delay line, gliding or
+  // crossfading between delay times depending on the delay mode
+  void readDelayLine(float delayInSamples, float &wetL, float &wetR) noexcept;
+
+  // Mode the delay line is read in, follows the parameter through
+  // switchDelayMode once a running crossfade has finished
+  DelayMode delayMode = DelayMode::GLIDE;
+  void switchDelayMode(float sampleRate) noexcept;
+
+  /*
+   Memory and threads that are only needed while their feature is on are
+   taken and given back as the feature is switched on and off: the
+   multiband buffer, the long delay file and its residency thread, and
+   the convolution worker. The change is picked up by a parameter
+   listener and handled on the message thread, never on the audio thread.
+   Offline renders call updateResources from processBlock instead, there
+   may be no message loop running.
+  */
+  void parameterChanged(const juce::String &parameterID,
+                        float newValue) override;
+  void handleAsyncUpdate() override;
+  void updateResources();
+
+  // Parameters that switch the features above on and off
+  const std::array<juce::ParameterID, 3> resourceParamIDs{
+      bandCountParamID, longDelayParamID, spaceParamID};
+
+  // Held while preparing, releasing and updating resources
+  juce::CriticalSection resourceLock;
+  bool prepared = false;
 };
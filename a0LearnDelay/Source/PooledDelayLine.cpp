@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    PooledDelayLine.cpp
+    Created: 19 Oct 2026 2:05:11pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "PooledDelayLine.h"
+
+PooledDelayLine::~PooledDelayLine() { releaseMemory(); }
+
+void PooledDelayLine::prepare(const juce::dsp::ProcessSpec &spec) {
+  jassert(spec.numChannels > 0);
+
+  // A different channel count or rate means the current slab is of no use
+  if (int(spec.numChannels) != numChannels || spec.sampleRate != sampleRate)
+    releaseMemory();
+
+  sampleRate = spec.sampleRate;
+  numChannels = int(spec.numChannels);
+
+  writePos.resize(size_t(numChannels));
+  readPos.resize(size_t(numChannels));
+  numWritten.resize(size_t(numChannels));
+}
+
+void PooledDelayLine::setMaximumDelayInSamples(int maxDelayInSamples) {
+  jassert(maxDelayInSamples >= 0);
+
+  // Two extra samples so the linear interpolation never reads past the end
+  int newSize = juce::jmax(4, maxDelayInSamples + 2);
+
+  // Same size as before, the current slab is reused as is
+  if (memory == nullptr || newSize != totalSize) {
+    releaseMemory();
+    totalSize = newSize;
+
+    // One run of interleaved frames, like the multiband band buffer
+    int stride = 0;
+    memory = pool->acquire(sampleRate, 1, totalSize * numChannels, stride);
+
+    // Out of memory, thrown like the std::vector in juce::dsp::DelayLine
+    if (memory == nullptr)
+      throw std::bad_alloc();
+  }
+
+  reset();
+}
+
+void PooledDelayLine::releaseMemory() noexcept {
+  pool->release(memory);
+  memory = nullptr;
+}
+
+void PooledDelayLine::reset() noexcept {
+  std::fill(writePos.begin(), writePos.end(), 0);
+  std::fill(readPos.begin(), readPos.end(), 0);
+
+  // Buffer contents are left alone, see numWritten
+  std::fill(numWritten.begin(), numWritten.end(), 0);
+}
+
+void PooledDelayLine::clearStale(int numSamples) noexcept {
+  numSamples = juce::jmin(numSamples, totalSize);
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    auto &written = numWritten[size_t(channel)];
+    float *samples = memory + channel;
+
+    // Ages written .. numSamples - 1 still hold stale data
+    for (int age = written; age < numSamples; ++age) {
+      int index = (writePos[size_t(channel)] + 1 + age) % totalSize;
+      samples[index * numChannels] = 0.0f;
+    }
+
+    written = juce::jmax(written, numSamples);
+  }
+}
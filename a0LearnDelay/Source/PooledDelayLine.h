@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    PooledDelayLine.h
+    Created: 19 Oct 2026 2:05:11pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayMemoryPool.h"
+#include <JuceHeader.h>
+
+/*
+ Drop-in replacement for
+ juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>
+ whose memory comes from the shared DelayMemoryPool.
+
+ The read/write pointer handling is the same as the JUCE class (both move
+ backwards through the buffer, a delay of 0 returns the sample that was
+ just pushed), so processBlock behaves exactly as before.
+
+ The buffer is frame-interleaved (L R L R ... for stereo), unlike the
+ planar JUCE class. The channels of one time index sit next to each
+ other, so pushing or popping a whole frame touches one cache line instead
+ of one per channel, which matters once long delays no longer fit in the
+ cache. processBlock reads one frame per sample and writes it to the
+ planar wet buffer, that is where the de-interleaving happens.
+ Tests/PooledDelayLineBenchmarks.cpp compares it with the planar class.
+
+ reset() does not clear the buffer. Each channel counts the samples
+ pushed since the reset and anything older reads as silence, so the
+ stale contents are cleared lazily as the write head passes over them.
+*/
+class PooledDelayLine {
+public:
+  PooledDelayLine() = default;
+  ~PooledDelayLine();
+
+  void prepare(const juce::dsp::ProcessSpec &spec);
+
+  // Takes a slab from the pool, keeping the current one if it already fits.
+  // Throws std::bad_alloc when there is no memory, like juce::dsp::DelayLine.
+  void setMaximumDelayInSamples(int maxDelayInSamples);
+  int getMaximumDelayInSamples() const noexcept { return totalSize - 2; }
+
+  // Hands the slab back to the pool, prepare has to be called again before
+  // processing
+  void releaseMemory() noexcept;
+
+  void reset() noexcept;
+
+  void setDelay(float newDelayInSamples) noexcept {
+    delay = juce::jlimit(0.0f, float(getMaximumDelayInSamples()),
+                         newDelayInSamples);
+    delayInt = int(delay);
+    delayFrac = delay - float(delayInt);
+  }
+
+  float getDelay() const noexcept { return delay; }
+
+  void pushSample(int channel, float sample) noexcept {
+    auto &pos = writePos[size_t(channel)];
+    memory[pos * numChannels + channel] = sample;
+    pos = pos == 0 ? totalSize - 1 : pos - 1;
+
+    auto &written = numWritten[size_t(channel)];
+    if (written < totalSize)
+      ++written;
+  }
+
+  float popSample(int channel, float delayInSamples = -1.0f,
+                  bool updateReadPointer = true) noexcept {
+    if (delayInSamples >= 0.0f)
+      setDelay(delayInSamples);
+
+    auto &pos = readPos[size_t(channel)];
+    const float *samples = memory + channel;
+
+    int index1 = pos + delayInt;
+    int index2 = index1 + 1;
+
+    if (index2 >= totalSize) {
+      index1 %= totalSize;
+      index2 %= totalSize;
+    }
+
+    float value1 = samples[index1 * numChannels];
+    float value2 = samples[index2 * numChannels];
+
+    // Only true until the buffer has been filled once after reset()
+    int written = numWritten[size_t(channel)];
+    if (written < totalSize) {
+      if (delayInt >= written)
+        value1 = 0.0f;
+      if (delayInt + 1 >= written)
+        value2 = 0.0f;
+    }
+
+    float result = value1 + delayFrac * (value2 - value1);
+
+    if (updateReadPointer)
+      pos = pos == 0 ? totalSize - 1 : pos - 1;
+
+    return result;
+  }
+
+  /*
+   Direct buffer access for reading the history without the delay line
+   moving, e.g. FreezeLooper. Frames are getNumChannels() samples apart.
+   The frame pushed last is at getWritePosition() + 1 and older frames
+   follow at increasing indices, wrapping at getBufferSize().
+  */
+  const float *getData() const noexcept { return memory; }
+  int getNumChannels() const noexcept { return numChannels; }
+  int getWritePosition(int channel) const noexcept {
+    return writePos[size_t(channel)];
+  }
+  int getBufferSize() const noexcept { return totalSize; }
+
+  // Makes sure the last numSamples samples of every channel can be read
+  // directly, zeroing whatever the lazy reset has not overwritten yet
+  void clearStale(int numSamples) noexcept;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PooledDelayLine)
+
+  juce::SharedResourcePointer<DelayMemoryPool> pool;
+
+  // totalSize frames of numChannels samples
+  float *memory = nullptr;
+
+  std::vector<int> writePos, readPos;
+
+  // Samples pushed per channel since reset(), stops counting at totalSize
+  std::vector<int> numWritten;
+
+  double sampleRate = 44100.0;
+  int numChannels = 0;
+  int totalSize = 4;
+
+  float delay = 0.0f;
+  int delayInt = 0;
+  float delayFrac = 0.0f;
+};
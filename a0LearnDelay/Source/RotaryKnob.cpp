@@ -9,7 +9,6 @@
 */
 
 #include "RotaryKnob.h"
-#include "LookAndFeel.h"
 #include <JuceHeader.h>
 
 //==============================================================================
@@ -17,10 +16,48 @@ RotaryKnob::RotaryKnob(const juce::String &text,
                        juce::AudioProcessorValueTreeState &apvts,
                        const juce::ParameterID &parameterID,
                        bool drawFromMiddle)
-    : attachment(apvts, parameterID.getParamID(), slider) {
+    : parameter(*apvts.getParameter(parameterID.getParamID())) {
   // In your constructor, you should add any child components, and
   // initialise any special settings that your component needs.
 
+  // Same mapping and text conversion a SliderAttachment sets up
+  auto range = parameter.getNormalisableRange();
+  juce::NormalisableRange<double> sliderRange{
+      double(range.start), double(range.end),
+      [range](double, double, double normalised) {
+        return double(range.convertFrom0to1(float(normalised)));
+      },
+      [range](double, double, double value) {
+        return double(range.convertTo0to1(float(value)));
+      },
+      [range](double, double, double value) {
+        return double(range.snapToLegalValue(float(value)));
+      }};
+  sliderRange.interval = double(range.interval);
+  slider.setNormalisableRange(sliderRange);
+  slider.textFromValueFunction = [this](double value) {
+    return parameter.getText(parameter.convertTo0to1(float(value)), 0);
+  };
+  slider.valueFromTextFunction = [this](const juce::String &text) {
+    return double(parameter.convertFrom0to1(parameter.getValueForText(text)));
+  };
+  slider.setDoubleClickReturnValue(
+      true, double(parameter.convertFrom0to1(parameter.getDefaultValue())));
+
+  // Listen first, a change in between only marks the knob dirty
+  parameter.addListener(this);
+  slider.setValue(double(parameter.convertFrom0to1(parameter.getValue())),
+                  juce::dontSendNotification);
+
+  // Only user changes notify, updates from the parameter do not
+  slider.onValueChange = [this] {
+    float value = parameter.convertTo0to1(float(slider.getValue()));
+    if (value != parameter.getValue())
+      parameter.setValueNotifyingHost(value);
+  };
+  slider.onDragStart = [this] { parameter.beginChangeGesture(); };
+  slider.onDragEnd = [this] { parameter.endChangeGesture(); };
+
   float pi = juce::MathConstants<float>::pi;
   slider.setRotaryParameters(1.25f * pi, 2.75f * pi, true);
   slider.setSliderStyle(
@@ -37,15 +74,27 @@ RotaryKnob::RotaryKnob(const juce::String &text,
   label.attachToComponent(&slider, false);
   addAndMakeVisible(label);
 
-  setLookAndFeel(RotaryKnobLookAndFeel::get());
+  setLookAndFeel(&resources->rotaryKnobLF);
 
   setSize(70, 110); // 110 = 86 (full slider height) + 24 (label height)
 }
 
-RotaryKnob::~RotaryKnob() {}
+RotaryKnob::~RotaryKnob() {
+  parameter.removeListener(this);
+  setLookAndFeel(nullptr);
+}
 
 void RotaryKnob::resized() {
   // This method is where you should set the bounds of any child
   // components that your component contains..
   slider.setTopLeftPosition(0, 24);
 }
+
+void RotaryKnob::updateFromParameter() {
+  if (!dirty.exchange(false))
+    return;
+
+  // The slider only repaints if the value is actually different
+  slider.setValue(double(parameter.convertFrom0to1(parameter.getValue())),
+                  juce::dontSendNotification);
+}
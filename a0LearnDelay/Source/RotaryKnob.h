@@ -10,12 +10,22 @@
 
 #pragma once
 
+#include "LookAndFeel.h"
 #include <JuceHeader.h>
 
 //==============================================================================
 /*
- */
-class RotaryKnob : public juce::Component {
+ Rotary slider for one parameter, drawn by RotaryKnobLookAndFeel.
+
+ Instead of a SliderAttachment, which updates and repaints the slider for
+ every single change, the knob only marks itself dirty when the parameter
+ changes, from whatever thread the host automates on. Once per display
+ frame it catches up with the latest value, so dense automation costs at
+ most one repaint per frame and knobs whose parameter did not move are
+ not touched at all. Moving the knob sets the parameter straight away.
+*/
+class RotaryKnob : public juce::Component,
+                   private juce::AudioProcessorParameter::Listener {
 public:
   RotaryKnob(const juce::String &text,
              juce::AudioProcessorValueTreeState &apvts,
@@ -26,8 +36,22 @@ public:
 
   juce::Slider slider;
   juce::Label label;
-  juce::AudioProcessorValueTreeState::SliderAttachment attachment;
 
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RotaryKnob)
+
+  void parameterValueChanged(int, float) override { dirty.store(true); }
+  void parameterGestureChanged(int, bool) override {}
+
+  // Called every display frame on the message thread
+  void updateFromParameter();
+
+  juce::RangedAudioParameter &parameter;
+  std::atomic<bool> dirty{false};
+
+  juce::VBlankAttachment vBlankAttachment{this, [this] {
+                                            updateFromParameter();
+                                          }};
+
+  juce::SharedResourcePointer<EditorResources> resources;
 };
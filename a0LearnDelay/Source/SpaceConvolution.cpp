@@ -0,0 +1,475 @@
+/*
+  ==============================================================================
+
+    SpaceConvolution.cpp
+    Created: 20 Oct 2026 2:37:19pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "SpaceConvolution.h"
+
+// Head covers the tail's first two blocks, one to collect and one to compute
+static constexpr int headLength = 2 * SpaceConvolution::tailPartitionSize;
+
+//==============================================================================
+void SpaceConvolution::Partitions::init(const float *impulse, int length,
+                                        int newPartitionSize) {
+  partitionSize = newPartitionSize;
+  numPartitions = juce::jmax(0, (length + partitionSize - 1) / partitionSize);
+
+  // Real-only FFT of twice the partition size, partitionSize + 1 complex bins
+  spectrumSize = 2 * (partitionSize + 1);
+  fft = std::make_unique<juce::dsp::FFT>(
+      juce::findHighestSetBit(juce::uint32(2 * partitionSize)));
+
+  impulseSpectra.assign(size_t(numPartitions * spectrumSize), 0.0f);
+  delayLine.assign(size_t(numPartitions * spectrumSize), 0.0f);
+  delayLinePosition = 0;
+
+  window.assign(size_t(2 * partitionSize), 0.0f);
+  fftBuffer.assign(size_t(4 * partitionSize), 0.0f);
+
+  for (int i = 0; i < numPartitions; ++i) {
+    int start = i * partitionSize;
+    int count = juce::jmin(partitionSize, length - start);
+
+    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+    std::copy(impulse + start, impulse + start + count, fftBuffer.begin());
+
+    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+    std::copy(fftBuffer.begin(), fftBuffer.begin() + spectrumSize,
+              impulseSpectra.begin() + i * spectrumSize);
+  }
+}
+
+void SpaceConvolution::Partitions::process(const float *input,
+                                           float *output) noexcept {
+  float *buffer = fftBuffer.data();
+
+  // Overlap-save, the previous and the new input block are transformed
+  std::copy(window.begin() + partitionSize, window.end(), window.begin());
+  std::copy(input, input + partitionSize, window.begin() + partitionSize);
+
+  std::copy(window.begin(), window.end(), buffer);
+  std::fill(buffer + 2 * partitionSize, buffer + 4 * partitionSize, 0.0f);
+
+  fft->performRealOnlyForwardTransform(buffer, true);
+
+  delayLinePosition =
+      (delayLinePosition == 0 ? numPartitions : delayLinePosition) - 1;
+  std::copy(buffer, buffer + spectrumSize,
+            delayLine.begin() + delayLinePosition * spectrumSize);
+
+  // Newest input spectrum with the first partition, older ones with the
+  // later partitions
+  std::fill(buffer, buffer + 4 * partitionSize, 0.0f);
+
+  for (int i = 0; i < numPartitions; ++i) {
+    int slot = (delayLinePosition + i) % numPartitions;
+    const float *x = delayLine.data() + slot * spectrumSize;
+    const float *h = impulseSpectra.data() + i * spectrumSize;
+
+    for (int bin = 0; bin < spectrumSize; bin += 2) {
+      buffer[bin] += x[bin] * h[bin] - x[bin + 1] * h[bin + 1];
+      buffer[bin + 1] += x[bin] * h[bin + 1] + x[bin + 1] * h[bin];
+    }
+  }
+
+  fft->performRealOnlyInverseTransform(buffer);
+
+  // Only the second half is free of wrap-around
+  std::copy(buffer + partitionSize, buffer + 2 * partitionSize, output);
+}
+
+void SpaceConvolution::Partitions::reset() noexcept {
+  std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+  std::fill(window.begin(), window.end(), 0.0f);
+  delayLinePosition = 0;
+}
+
+//==============================================================================
+SpaceConvolution::Kernel::Kernel(SpaceImpulses::Type type, double sampleRate)
+    : type(type) {
+  std::vector<float> impulse;
+
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    SpaceImpulses::create(type, sampleRate, int(channel), impulse);
+
+    int length = int(impulse.size());
+    head[channel].init(impulse.data(), juce::jmin(length, headLength),
+                       headPartitionSize);
+
+    if (length > headLength)
+      tail[channel].init(impulse.data() + headLength, length - headLength,
+                         tailPartitionSize);
+
+    tailInputData[channel].assign(size_t(tailInput.getTotalSize()), 0.0f);
+    tailOutputData[channel].assign(size_t(tailOutput.getTotalSize()), 0.0f);
+    tailBlock[channel].assign(size_t(tailPartitionSize), 0.0f);
+    tailResult[channel].assign(size_t(tailPartitionSize), 0.0f);
+  }
+}
+
+void SpaceConvolution::Kernel::reset() noexcept {
+  tailInput.reset();
+  tailOutput.reset();
+
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    head[channel].reset();
+    tail[channel].reset();
+  }
+}
+
+//==============================================================================
+SpaceConvolution::SpaceConvolution() : juce::Thread("Space Convolution") {
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    blockInput[channel].assign(size_t(headPartitionSize), 0.0f);
+    previousInput[channel].assign(size_t(headPartitionSize), 0.0f);
+    blockOutput[channel].assign(size_t(headPartitionSize), 0.0f);
+  }
+}
+
+SpaceConvolution::~SpaceConvolution() { releaseResources(); }
+
+void SpaceConvolution::prepareToPlay(double sampleRate) {
+  // Kernels are built for one sample rate, the same rate keeps them
+  if (sampleRate != preparedSampleRate)
+    releaseResources();
+  else
+    stopThread(1000);
+
+  preparedSampleRate = sampleRate;
+  reset();
+
+  if (enabled)
+    startThread();
+}
+
+void SpaceConvolution::releaseResources() {
+  stopThread(1000);
+
+  // Nothing else touches the kernels with the worker stopped
+  delete pendingKernel.exchange(nullptr);
+  delete retiredKernel.exchange(nullptr);
+  activeKernel.store(nullptr);
+  delete kernel;
+  kernel = nullptr;
+
+  builtSpace = 0;
+}
+
+void SpaceConvolution::setEnabled(bool shouldBeEnabled) {
+  enabled = shouldBeEnabled;
+
+  if (enabled) {
+    if (preparedSampleRate > 0.0 && !isThreadRunning())
+      startThread();
+    return;
+  }
+
+  stopThread(1000);
+
+  /*
+   The worker is not there to delete them. A kernel the audio thread only
+   hands back after this waits for the worker to start again or for
+   releaseResources.
+  */
+  delete pendingKernel.exchange(nullptr, std::memory_order_acq_rel);
+  delete retiredKernel.exchange(nullptr, std::memory_order_acq_rel);
+  builtSpace = 0;
+}
+
+void SpaceConvolution::reset() noexcept {
+  // The worker is stopped, nothing else touches the kernel
+  if (kernel != nullptr)
+    kernel->reset();
+
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    std::fill(blockInput[channel].begin(), blockInput[channel].end(), 0.0f);
+    std::fill(previousInput[channel].begin(), previousInput[channel].end(),
+              0.0f);
+    std::fill(blockOutput[channel].begin(), blockOutput[channel].end(), 0.0f);
+  }
+
+  blockPosition = 0;
+  headBlocks = 0;
+  tailDebt = 0;
+  lastAmount = 0.0f;
+
+  // Same fade in as a kernel coming on from off, renders start alike
+  waitingForOutput = true;
+}
+
+void SpaceConvolution::setSpace(int space) noexcept {
+  // Switched off, process fades the kernel out and then hands it back for
+  // the worker to delete
+  requestedSpace.store(space, std::memory_order_relaxed);
+}
+
+void SpaceConvolution::retireKernel() noexcept {
+  if (kernel == nullptr ||
+      retiredKernel.load(std::memory_order_acquire) != nullptr)
+    return;
+
+  activeKernel.store(nullptr, std::memory_order_release);
+  retiredKernel.store(kernel, std::memory_order_release);
+  kernel = nullptr;
+}
+
+void SpaceConvolution::swapKernel() noexcept {
+  // The old kernel can only be handed back once the worker took the last
+  if (pendingKernel.load(std::memory_order_acquire) == nullptr ||
+      retiredKernel.load(std::memory_order_acquire) != nullptr)
+    return;
+
+  Kernel *next = pendingKernel.exchange(nullptr, std::memory_order_acq_rel);
+  if (next == nullptr)
+    return;
+
+  /*
+   The block in flight keeps playing the output of the old kernel, the
+   new one takes over with the next block. Coming from off there is no
+   output yet, the blend stays at 0 until the first block is convolved.
+   The dry history kept running while off, it holds the real input.
+  */
+  if (kernel == nullptr) {
+    for (size_t channel = 0; channel < size_t(numChannels); ++channel)
+      std::fill(blockOutput[channel].begin(), blockOutput[channel].end(),
+                0.0f);
+
+    waitingForOutput = true;
+  }
+
+  activeKernel.store(next, std::memory_order_release);
+  retiredKernel.store(kernel, std::memory_order_release);
+  kernel = next;
+
+  headBlocks = 0;
+  tailDebt = 0;
+}
+
+void SpaceConvolution::process(juce::AudioBuffer<float> &buffer,
+                               int numSamples, float amount) noexcept {
+  swapKernel();
+
+  // Offline the worker is woken up and waited for, for a second at most
+  if (nonRealtime) {
+    int space = requestedSpace.load(std::memory_order_relaxed);
+
+    for (int attempt = 0;
+         attempt < 1000 && space != 0 &&
+         (kernel == nullptr || int(kernel->type) != space);
+         ++attempt) {
+      notify();
+      juce::Thread::sleep(1);
+      swapKernel();
+    }
+  }
+
+  /*
+   The unprocessed signal is delayed whether there is a kernel or not, so
+   the latency never changes. Without a kernel, or switched off, the blend
+   ramps to 0 and only the delayed signal comes out.
+  */
+  bool switchedOff = requestedSpace.load(std::memory_order_relaxed) == 0;
+  float target = amount;
+  if (kernel == nullptr || switchedOff || waitingForOutput)
+    target = 0.0f;
+
+  // Blend ramped across the block so amount changes do not step
+  float step = (target - lastAmount) / float(numSamples);
+
+  for (int start = 0; start < numSamples;) {
+    int count = juce::jmin(headPartitionSize - blockPosition,
+                           numSamples - start);
+
+    for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+      float *data = buffer.getWritePointer(int(channel)) + start;
+      float *input = blockInput[channel].data() + blockPosition;
+      const float *dry = previousInput[channel].data() + blockPosition;
+      const float *wet = blockOutput[channel].data() + blockPosition;
+
+      for (int i = 0; i < count; ++i) {
+        float blend = lastAmount + step * float(start + i + 1);
+
+        input[i] = data[i];
+        data[i] = dry[i] + blend * (wet[i] - dry[i]);
+      }
+    }
+
+    blockPosition += count;
+    start += count;
+
+    if (blockPosition == headPartitionSize) {
+      if (kernel != nullptr) {
+        processHeadBlock(*kernel);
+        waitingForOutput = false;
+      }
+
+      std::swap(blockInput, previousInput);
+      blockPosition = 0;
+    }
+  }
+
+  lastAmount = target;
+
+  // Faded out, the kernel goes and is rebuilt on the next selection
+  if (switchedOff && lastAmount == 0.0f)
+    retireKernel();
+}
+
+void SpaceConvolution::processHeadBlock(Kernel &k) noexcept {
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel)
+    k.head[channel].process(blockInput[channel].data(),
+                            blockOutput[channel].data());
+
+  if (!k.tail[0].isEmpty()) {
+    // Hand the block to the worker, a full FIFO means it has stalled and
+    // the tail drops out
+    int start1, size1, start2, size2;
+    k.tailInput.prepareToWrite(headPartitionSize, start1, size1, start2,
+                               size2);
+
+    if (size1 + size2 == headPartitionSize) {
+      for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+        const float *input = blockInput[channel].data();
+        float *fifo = k.tailInputData[channel].data();
+
+        std::copy(input, input + size1, fifo + start1);
+        std::copy(input + size1, input + size1 + size2, fifo + start2);
+      }
+
+      k.tailInput.finishedWrite(headPartitionSize);
+    }
+
+    // Offline the tail is ready before it is due, there is no debt
+    if (nonRealtime) {
+      const juce::ScopedLock lock(tailLock);
+      while (k.tailInput.getNumReady() >= tailPartitionSize)
+        processTail(k);
+    }
+
+    // The tail starts headLength samples into the response
+    if (headBlocks * headPartitionSize >= headLength) {
+      int ready = k.tailOutput.getNumReady();
+
+      // Catch up on the samples the worker was late with last time
+      int skip = juce::jmin(tailDebt, ready);
+      if (skip > 0) {
+        k.tailOutput.prepareToRead(skip, start1, size1, start2, size2);
+        k.tailOutput.finishedRead(skip);
+        tailDebt -= skip;
+        ready -= skip;
+      }
+
+      if (tailDebt == 0 && ready >= headPartitionSize) {
+        k.tailOutput.prepareToRead(headPartitionSize, start1, size1, start2,
+                                   size2);
+
+        for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+          float *output = blockOutput[channel].data();
+          const float *fifo = k.tailOutputData[channel].data();
+
+          for (int i = 0; i < size1; ++i)
+            output[i] += fifo[start1 + i];
+          for (int i = 0; i < size2; ++i)
+            output[size1 + i] += fifo[start2 + i];
+        }
+
+        k.tailOutput.finishedRead(headPartitionSize);
+      } else {
+        tailDebt += headPartitionSize;
+      }
+    } else {
+      ++headBlocks;
+    }
+  }
+}
+
+//==============================================================================
+void SpaceConvolution::run() {
+  while (!threadShouldExit()) {
+    Kernel *retired =
+        retiredKernel.exchange(nullptr, std::memory_order_acq_rel);
+
+    if (retired != nullptr) {
+      delete retired;
+
+      /*
+       Handed back without a successor, nothing that was built is left.
+       The space may have gone off and on again faster than this loop
+       polls, so requestedSpace alone does not show it.
+      */
+      if (activeKernel.load(std::memory_order_acquire) == nullptr &&
+          pendingKernel.load(std::memory_order_acquire) == nullptr)
+        builtSpace = 0;
+    }
+
+    int space = requestedSpace.load(std::memory_order_relaxed);
+
+    if (space != builtSpace) {
+      if (space == 0) {
+        delete pendingKernel.exchange(nullptr, std::memory_order_acq_rel);
+        builtSpace = 0;
+      } else if (pendingKernel.load(std::memory_order_acquire) == nullptr) {
+        auto type = SpaceImpulses::Type(space);
+        pendingKernel.store(new Kernel(type, preparedSampleRate),
+                            std::memory_order_release);
+        builtSpace = space;
+      }
+    }
+
+    Kernel *k = activeKernel.load(std::memory_order_acquire);
+
+    bool busy = false;
+    if (k != nullptr && !k->tail[0].isEmpty()) {
+      const juce::ScopedLock lock(tailLock);
+      while (k->tailInput.getNumReady() >= tailPartitionSize) {
+        processTail(*k);
+        busy = true;
+      }
+    }
+
+    // A tail block arrives every tailPartitionSize samples and has as long
+    // again until it is due, polling well within that keeps the audio
+    // thread from ever having to signal. Idle, only a new space is waited
+    // for.
+    if (!busy)
+      wait(k != nullptr ? 2 : 100);
+  }
+}
+
+void SpaceConvolution::processTail(Kernel &k) noexcept {
+  int start1, size1, start2, size2;
+
+  k.tailInput.prepareToRead(tailPartitionSize, start1, size1, start2, size2);
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    const float *fifo = k.tailInputData[channel].data();
+    float *block = k.tailBlock[channel].data();
+
+    std::copy(fifo + start1, fifo + start1 + size1, block);
+    std::copy(fifo + start2, fifo + start2 + size2, block + size1);
+  }
+  k.tailInput.finishedRead(tailPartitionSize);
+
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel)
+    k.tail[channel].process(k.tailBlock[channel].data(),
+                            k.tailResult[channel].data());
+
+  k.tailOutput.prepareToWrite(tailPartitionSize, start1, size1, start2,
+                              size2);
+  if (size1 + size2 < tailPartitionSize)
+    return;
+
+  for (size_t channel = 0; channel < size_t(numChannels); ++channel) {
+    const float *result = k.tailResult[channel].data();
+    float *fifo = k.tailOutputData[channel].data();
+
+    std::copy(result, result + size1, fifo + start1);
+    std::copy(result + size1, result + size1 + size2, fifo + start2);
+  }
+  k.tailOutput.finishedWrite(tailPartitionSize);
+}
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    SpaceConvolution.h
+    Created: 20 Oct 2026 2:37:19pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SpaceImpulses.h"
+#include <JuceHeader.h>
+
+/*
+ Convolution of the wet signal with one of the SpaceImpulses.
+
+ The impulse response is split in two:
+    - Head : the first 2 * tailPartitionSize samples, uniformly
+             partitioned in blocks of headPartitionSize and convolved on
+             the audio thread
+    - Tail : everything after, in blocks of tailPartitionSize, convolved
+             on a worker thread
+
+ The audio thread hands every finished head block to the worker through
+ a lock-free FIFO and takes the tail output back through another one.
+ The tail output is only needed 2 * tailPartitionSize samples after its
+ input, so the worker has a whole tail block of time to deliver it and
+ the audio thread cost stays flat whatever the length of the response.
+
+ Impulse responses are built and transformed on the same worker thread.
+ A finished kernel is passed to the audio thread through an atomic
+ pointer and the one it replaces goes back the same way to be deleted.
+ The worker only runs while a space is selected, see setEnabled.
+
+ Offline rendering has no deadline, so nothing is left to the worker's
+ timing there. The audio thread waits for a new kernel and convolves the
+ tail itself, and renders come out the same every time.
+
+ The convolved signal is headPartitionSize samples late, the unprocessed
+ signal it is blended with is delayed by the same amount. That delay runs
+ with the space switched off too, so switching it on or off only fades
+ between the two and the timing of the wet signal never jumps.
+*/
+class SpaceConvolution : private juce::Thread {
+public:
+  SpaceConvolution();
+  ~SpaceConvolution() override;
+
+  void prepareToPlay(double sampleRate);
+
+  // Stops the worker and frees all kernels
+  void releaseResources();
+
+  // Not on the audio thread. Starts the worker, or stops it and frees the
+  // kernels the audio thread has handed back.
+  void setEnabled(bool shouldBeEnabled);
+
+  // Offline rendering waits for kernels and convolves the tail on the
+  // calling thread instead of dropping what the worker has not delivered
+  void setNonRealtime(bool isNonRealtime) noexcept {
+    nonRealtime = isNonRealtime;
+  }
+
+  // 0 switches the convolution off, otherwise a SpaceImpulses::Type
+  void setSpace(int space) noexcept;
+
+  // amount blends from the input (0) to the convolved signal (1),
+  // processes the buffer in place
+  void process(juce::AudioBuffer<float> &buffer, int numSamples,
+               float amount) noexcept;
+
+  static constexpr int headPartitionSize = 128;
+  static constexpr int tailPartitionSize = 1024;
+  static constexpr int numChannels = 2;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpaceConvolution)
+
+  /*
+   Uniformly partitioned overlap-save convolution with a frequency domain
+   delay line. All memory is allocated in init, process does not allocate.
+  */
+  class Partitions {
+  public:
+    void init(const float *impulse, int length, int newPartitionSize);
+
+    // Takes partitionSize input samples and writes partitionSize output
+    void process(const float *input, float *output) noexcept;
+
+    // Forgets the input, keeps the impulse response
+    void reset() noexcept;
+
+    bool isEmpty() const noexcept { return numPartitions == 0; }
+
+  private:
+    int partitionSize = 0;
+    int numPartitions = 0;
+    int spectrumSize = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+
+    std::vector<float> impulseSpectra;
+    std::vector<float> delayLine;
+    int delayLinePosition = 0;
+
+    std::vector<float> window;
+    std::vector<float> fftBuffer;
+  };
+
+  // Everything that depends on the impulse response, built by the worker
+  struct Kernel {
+    Kernel(SpaceImpulses::Type type, double sampleRate);
+
+    // Only with the worker stopped
+    void reset() noexcept;
+
+    const SpaceImpulses::Type type;
+
+    std::array<Partitions, numChannels> head;
+    std::array<Partitions, numChannels> tail;
+
+    // Head blocks to the worker and tail output back, both channels share
+    // the indices of one FIFO
+    juce::AbstractFifo tailInput{8 * tailPartitionSize};
+    juce::AbstractFifo tailOutput{8 * tailPartitionSize};
+    std::array<std::vector<float>, numChannels> tailInputData;
+    std::array<std::vector<float>, numChannels> tailOutputData;
+
+    // Worker side block buffers
+    std::array<std::vector<float>, numChannels> tailBlock;
+    std::array<std::vector<float>, numChannels> tailResult;
+  };
+
+  void run() override;
+  void processTail(Kernel &kernel) noexcept;
+  void swapKernel() noexcept;
+  void retireKernel() noexcept;
+  void processHeadBlock(Kernel &kernel) noexcept;
+  void reset() noexcept;
+
+  double preparedSampleRate = 0.0;
+
+  // Set through setEnabled, the worker runs while prepared and enabled
+  bool enabled = false;
+
+  // Requested by the audio thread, built by the worker
+  std::atomic<int> requestedSpace{0};
+  int builtSpace = 0;
+
+  // Whoever reads the tail input, the worker or offline the audio thread
+  juce::CriticalSection tailLock;
+  bool nonRealtime = false;
+
+  // Worker -> audio thread: new kernel, audio thread -> worker: old one
+  std::atomic<Kernel *> pendingKernel{nullptr};
+  std::atomic<Kernel *> retiredKernel{nullptr};
+
+  // Kernel in use, owned by the audio thread, read by the worker
+  std::atomic<Kernel *> activeKernel{nullptr};
+  Kernel *kernel = nullptr;
+
+  // Head block being filled and the previous block, whose input is the
+  // delayed unprocessed signal and whose output is played now
+  std::array<std::vector<float>, numChannels> blockInput;
+  std::array<std::vector<float>, numChannels> previousInput;
+  std::array<std::vector<float>, numChannels> blockOutput;
+  int blockPosition = 0;
+
+  // Head blocks since the kernel was swapped in, the tail output starts
+  // after 2 * tailPartitionSize samples
+  int headBlocks = 0;
+
+  // Tail samples the worker was late with, skipped once they do arrive
+  int tailDebt = 0;
+
+  float lastAmount = 0.0f;
+
+  // A kernel that came on from off has no output until its first block
+  bool waitingForOutput = false;
+};
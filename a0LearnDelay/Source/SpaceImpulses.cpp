@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    SpaceImpulses.cpp
+    Created: 20 Oct 2026 2:37:19pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "SpaceImpulses.h"
+
+namespace SpaceImpulses {
+
+double getLengthInSeconds(Type type) noexcept {
+  switch (type) {
+  case Type::TAPE_HEAD:
+    return 0.02;
+  case Type::SPRING:
+    return 2.0;
+  case Type::SMALL_ROOM:
+    return 0.5;
+  }
+
+  return 0.0;
+}
+
+// One-pole lowpass run over the impulse in place
+static void lowpass(std::vector<float> &impulse, double sampleRate,
+                    double cutoff) {
+  float coeff =
+      float(1.0 - std::exp(-juce::MathConstants<double>::twoPi * cutoff /
+                           sampleRate));
+  float state = 0.0f;
+
+  for (auto &sample : impulse) {
+    state += (sample - state) * coeff;
+    sample = state;
+  }
+}
+
+static void normalise(std::vector<float> &impulse) {
+  double energy = 0.0;
+  for (float sample : impulse)
+    energy += double(sample) * double(sample);
+
+  if (energy > 0.0) {
+    float scale = float(1.0 / std::sqrt(energy));
+    for (auto &sample : impulse)
+      sample *= scale;
+  }
+}
+
+static void createTapeHead(double sampleRate, std::vector<float> &impulse) {
+  impulse.assign(size_t(getLengthInSeconds(Type::TAPE_HEAD) * sampleRate),
+                 0.0f);
+  impulse[0] = 1.0f;
+
+  // Gap loss, the head cannot reproduce the highest frequencies
+  lowpass(impulse, sampleRate, 9000.0);
+
+  // Head bump, a damped resonance around 90 Hz
+  double omega = juce::MathConstants<double>::twoPi * 90.0 / sampleRate;
+  double decay = std::exp(-1.0 / (0.006 * sampleRate));
+  double envelope = 0.04;
+
+  for (size_t i = 0; i < impulse.size(); ++i) {
+    impulse[i] += float(envelope * std::sin(omega * double(i)));
+    envelope *= decay;
+  }
+}
+
+static void createSpring(double sampleRate, int channel,
+                         std::vector<float> &impulse) {
+  impulse.assign(size_t(getLengthInSeconds(Type::SPRING) * sampleRate), 0.0f);
+
+  juce::Random random(0x5eed + channel);
+
+  /*
+   Every trip along the spring comes back as a chirp, high frequencies
+   arrive first. The chirps repeat at the round trip time and die away
+   with a 2 s decay.
+  */
+  double roundTrip = (channel == 0 ? 0.0331 : 0.0357) * sampleRate;
+  int chirpLength = int(0.018 * sampleRate);
+  double t60 = 2.0 * sampleRate;
+
+  for (double start = 0.0; start < double(impulse.size());
+       start += roundTrip) {
+    double gain = std::pow(0.001, start / t60);
+    double phase = 0.0;
+
+    for (int i = 0; i < chirpLength; ++i) {
+      size_t index = size_t(start) + size_t(i);
+      if (index >= impulse.size())
+        break;
+
+      double position = double(i) / double(chirpLength);
+      double frequency = 4000.0 * std::pow(200.0 / 4000.0, position);
+      phase += juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+      double window = std::sin(juce::MathConstants<double>::pi * position);
+      impulse[index] += float(gain * window * std::sin(phase));
+    }
+  }
+
+  // A little diffuse noise between the chirps
+  double noiseDecay = std::pow(0.001, 1.0 / t60);
+  double noiseGain = 0.05;
+  for (auto &sample : impulse) {
+    sample += float(noiseGain * (random.nextFloat() * 2.0f - 1.0f));
+    noiseGain *= noiseDecay;
+  }
+
+  lowpass(impulse, sampleRate, 5000.0);
+}
+
+static void createSmallRoom(double sampleRate, int channel,
+                            std::vector<float> &impulse) {
+  impulse.assign(size_t(getLengthInSeconds(Type::SMALL_ROOM) * sampleRate),
+                 0.0f);
+
+  juce::Random random(0x7007 + channel);
+
+  impulse[0] = 1.0f;
+
+  // Early reflections off the nearest walls, times in milliseconds
+  const double reflections[]{3.1, 5.7, 7.9, 11.3, 13.7, 17.2, 19.9};
+  double reflectionGain = 0.6;
+
+  for (double time : reflections) {
+    double stretch = channel == 0 ? 1.0 : 1.09;
+    size_t index = size_t(time * stretch * 0.001 * sampleRate);
+
+    float sign = random.nextFloat() < 0.5f ? -1.0f : 1.0f;
+    impulse[index] += sign * float(reflectionGain);
+    reflectionGain *= 0.85;
+  }
+
+  // Dense tail from 20 ms on, 0.4 s decay
+  double decay = std::pow(0.001, 1.0 / (0.4 * sampleRate));
+  double gain = 0.25;
+
+  for (size_t i = size_t(0.02 * sampleRate); i < impulse.size(); ++i) {
+    impulse[i] += float(gain * (random.nextFloat() * 2.0f - 1.0f));
+    gain *= decay;
+  }
+
+  lowpass(impulse, sampleRate, 7000.0);
+}
+
+void create(Type type, double sampleRate, int channel,
+            std::vector<float> &impulse) {
+  switch (type) {
+  case Type::TAPE_HEAD:
+    createTapeHead(sampleRate, impulse);
+    break;
+  case Type::SPRING:
+    createSpring(sampleRate, channel, impulse);
+    break;
+  case Type::SMALL_ROOM:
+    createSmallRoom(sampleRate, channel, impulse);
+    break;
+  }
+
+  normalise(impulse);
+}
+
+} // namespace SpaceImpulses
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    SpaceImpulses.h
+    Created: 20 Oct 2026 2:37:19pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Impulse responses for the space convolution, built from a fixed recipe
+ at the sample rate they are needed at:
+    - Tape head : playback head colour, high frequency loss plus the low
+                  frequency head bump, 20 ms
+    - Spring : dispersive chirps repeating at the spring round trip
+               time, 2 s
+    - Small room : early reflections into a dense damped tail, 0.5 s
+
+ The two channels use different random seeds for a wider image. Every
+ response is normalised to unit energy so switching keeps the level.
+
+ Building one takes a few milliseconds, only call it off the audio thread.
+*/
+namespace SpaceImpulses {
+enum class Type { TAPE_HEAD = 1, SPRING, SMALL_ROOM };
+
+void create(Type type, double sampleRate, int channel,
+            std::vector<float> &impulse);
+
+// Length of the response create() builds
+double getLengthInSeconds(Type type) noexcept;
+} // namespace SpaceImpulses
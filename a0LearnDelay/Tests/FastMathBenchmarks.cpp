@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    FastMathBenchmarks.cpp
+    Created: 22 Oct 2026 10:14:52am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "../Source/FastMath.h"
+
+/*
+ The forms of a function as lambdas, so the timed loops can inline them
+ the way the DSP code does. The four-lane form is nothing without SIMD.
+*/
+#define SCALAR_FUNCTION(name) [](float x) { return FastMath::name(x); }
+
+#if FASTMATH_HAS_SIMD
+#define SIMD_FUNCTION(name)                                                    \
+  [](FastMath::simd::Vec x) { return FastMath::simd::name(x); }
+#else
+#define SIMD_FUNCTION(name) nullptr
+#endif
+
+/*
+ Times dbToGain, exp2 and tanh in their scalar, SIMD and block forms
+ against juce::Decibels::decibelsToGain, std::exp2 and std::tanh. Every
+ form runs the same loop over the same values, one output per input.
+
+ Timings are only logged, they depend on the machine and the compiler.
+ What is checked is that every form stays within 1e-6 of the library
+ result, relative above 1 and absolute below. Run with
+ a0LearnDelayBatch --benchmark.
+*/
+class FastMathBenchmarks : public juce::UnitTest {
+public:
+  FastMathBenchmarks()
+      : juce::UnitTest("FastMath", "a0LearnDelay Benchmarks") {}
+
+  void runTest() override {
+    beginTest("dbToGain");
+    run(linear(-99.99f, 40.0f),
+        [](float x) { return juce::Decibels::decibelsToGain(x); },
+        SCALAR_FUNCTION(dbToGain), SIMD_FUNCTION(dbToGain),
+        FastMath::dbToGain);
+
+    beginTest("exp2");
+    run(linear(-126.0f, 126.0f), [](float x) { return std::exp2(x); },
+        SCALAR_FUNCTION(exp2), SIMD_FUNCTION(exp2), FastMath::exp2);
+
+    beginTest("tanh");
+    run(linear(-10.0f, 10.0f), [](float x) { return std::tanh(x); },
+        SCALAR_FUNCTION(tanh), SIMD_FUNCTION(tanh), FastMath::tanh);
+  }
+
+private:
+  // Half a megabyte of input, stays in the cache between passes
+  static constexpr size_t numValues = 1 << 17;
+  static constexpr int numPasses = 100;
+
+  static std::vector<float> linear(float start, float end) {
+    std::vector<float> values(numValues);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = start + (end - start) * float(i) / float(numValues - 1);
+    return values;
+  }
+
+  template <typename Reference, typename Scalar, typename Simd>
+  void run(const std::vector<float> &inputs, Reference reference,
+           Scalar scalar, Simd simd,
+           void (*block)(float *, const float *, int)) {
+    std::vector<float> expected(inputs.size());
+    std::vector<float> outputs(inputs.size());
+
+    double referenceSeconds = time([&] {
+      for (size_t i = 0; i < inputs.size(); ++i)
+        expected[i] = reference(inputs[i]);
+    });
+
+    double scalarSeconds = time([&] {
+      for (size_t i = 0; i < inputs.size(); ++i)
+        outputs[i] = scalar(inputs[i]);
+    });
+    check(outputs, expected, "scalar");
+    log("scalar", scalarSeconds, referenceSeconds);
+
+#if FASTMATH_HAS_SIMD
+    // numValues is a multiple of the width, there is no scalar tail
+    double simdSeconds = time([&] {
+      for (size_t i = 0; i < inputs.size(); i += FastMath::simd::width)
+        FastMath::simd::store(outputs.data() + i,
+                              simd(FastMath::simd::load(inputs.data() + i)));
+    });
+    check(outputs, expected, "SIMD");
+    log("SIMD", simdSeconds, referenceSeconds);
+#else
+    juce::ignoreUnused(simd);
+#endif
+
+    double blockSeconds = time([&] {
+      block(outputs.data(), inputs.data(), int(inputs.size()));
+    });
+    check(outputs, expected, "block");
+    log("block", blockSeconds, referenceSeconds);
+  }
+
+  // Seconds for numPasses calls of pass, after one untimed call to warm up
+  template <typename Pass> static double time(Pass &&pass) {
+    pass();
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (int i = 0; i < numPasses; ++i)
+      pass();
+
+    return juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - start);
+  }
+
+  void log(const char *form, double seconds, double referenceSeconds) {
+    double numSamples = double(numValues) * numPasses;
+    logMessage(juce::String::formatted(
+        "%s: %.2f ns, library %.2f ns per value, %.2fx", form,
+        seconds * 1.0e9 / numSamples, referenceSeconds * 1.0e9 / numSamples,
+        referenceSeconds / seconds));
+  }
+
+  void check(const std::vector<float> &outputs,
+             const std::vector<float> &expected, const char *form) {
+    float maxDifference = 0.0f;
+    for (size_t i = 0; i < outputs.size(); ++i)
+      maxDifference =
+          std::max(maxDifference, std::abs(outputs[i] - expected[i]) /
+                                      std::max(1.0f, std::abs(expected[i])));
+
+    expectLessOrEqual(maxDifference, 1.0e-6f,
+                      juce::String(form) + " versus library");
+  }
+};
+
+static FastMathBenchmarks fastMathBenchmarks;
+
+#undef SCALAR_FUNCTION
+#undef SIMD_FUNCTION
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    FastMathTests.cpp
+    Created: 21 Oct 2026 11:20:45am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "../Source/FastMath.h"
+
+/*
+ Checks the error bounds listed in FastMath.h against double precision
+ and that the block versions, SIMD where available, give the same results
+ as the scalar ones. Run with a0LearnDelayBatch --test.
+*/
+class FastMathTests : public juce::UnitTest {
+public:
+  FastMathTests() : juce::UnitTest("FastMath", "a0LearnDelay") {}
+
+  void runTest() override {
+    beginTest("exp2");
+    check(linear(-126.0, 126.0), FastMath::exp2, FastMath::exp2,
+          [](double x) { return std::exp2(x); }, Error::RELATIVE, 2.5e-7);
+
+    beginTest("log2");
+    check(logarithmic(1.0e-30, 1.0e30), FastMath::log2, FastMath::log2,
+          [](double x) { return std::log2(x); }, Error::ABSOLUTE, 4.0e-6);
+
+    // -100 dB itself is the floor, checked below
+    beginTest("dbToGain");
+    check(linear(-99.99, 40.0), FastMath::dbToGain, FastMath::dbToGain,
+          [](double x) { return std::pow(10.0, x / 20.0); }, Error::RELATIVE,
+          9.0e-7);
+
+    beginTest("gainToDb");
+    check(logarithmic(1.0e-5, 100.0), FastMath::gainToDb, FastMath::gainToDb,
+          [](double x) { return 20.0 * std::log10(x); }, Error::ABSOLUTE,
+          1.1e-5);
+
+    beginTest("tanh");
+    check(linear(-20.0, 20.0), FastMath::tanh, FastMath::tanh,
+          [](double x) { return std::tanh(x); }, Error::ABSOLUTE, 2.0e-7);
+
+    beginTest("Floors");
+    expectEquals(FastMath::dbToGain(FastMath::minusInfinityDb), 0.0f);
+    expectEquals(FastMath::gainToDb(0.0f), FastMath::minusInfinityDb);
+  }
+
+private:
+  enum class Error { RELATIVE, ABSOLUTE };
+
+  // A multiple of every SIMD width, so no value goes down the scalar tail
+  // of the block versions
+  static constexpr size_t numValues = 1 << 17;
+
+  // 0 for the first value to 1 for the last
+  static double position(size_t i) {
+    return double(i) / double(numValues - 1);
+  }
+
+  static std::vector<float> linear(double start, double end) {
+    std::vector<float> values(numValues);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = float(start + (end - start) * position(i));
+    return values;
+  }
+
+  static std::vector<float> logarithmic(double start, double end) {
+    std::vector<float> values(numValues);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = float(start * std::pow(end / start, position(i)));
+    return values;
+  }
+
+  template <typename Reference>
+  void check(const std::vector<float> &inputs, float (*scalar)(float),
+             void (*block)(float *, const float *, int), Reference reference,
+             Error error, double bound) {
+    std::vector<float> outputs(inputs.size());
+    block(outputs.data(), inputs.data(), int(inputs.size()));
+
+    double maxError = 0.0;
+    float maxDifference = 0.0f;
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      float value = scalar(inputs[i]);
+      double exact = reference(double(inputs[i]));
+
+      double difference = std::abs(double(value) - exact);
+      if (error == Error::RELATIVE)
+        difference /= std::abs(exact);
+      maxError = std::max(maxError, difference);
+
+      // In float steps of the scalar result. The platforms may fuse
+      // multiply-adds differently on the two paths, so allow one step.
+      float step = std::max(1.0f, std::abs(value)) *
+                   std::numeric_limits<float>::epsilon();
+      maxDifference =
+          std::max(maxDifference, std::abs(outputs[i] - value) / step);
+    }
+
+    expectLessOrEqual(maxError, bound, "error bound");
+    expectLessOrEqual(maxDifference, 1.0f, "block versus scalar");
+  }
+};
+
+static FastMathTests fastMathTests;
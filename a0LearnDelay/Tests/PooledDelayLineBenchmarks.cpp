@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    PooledDelayLineBenchmarks.cpp
+    Created: 21 Oct 2026 2:08:33pm
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "../Source/Parameters.h"
+#include "../Source/PooledDelayLine.h"
+
+/*
+ Times the frame-interleaved PooledDelayLine against the planar
+ juce::dsp::DelayLine it replaced, for 2, 8 and 16 channels at a delay
+ close to the maximum. At 16 channels the buffer is about 15 MB, far more
+ than the cache holds. Every frame is pushed and popped one channel after
+ the other, the way processBlock uses the delay line.
+
+ Timings are only logged, they depend on the machine. What is checked is
+ that both delay lines give the same output. Run with
+ a0LearnDelayBatch --benchmark.
+*/
+class PooledDelayLineBenchmarks : public juce::UnitTest {
+public:
+  PooledDelayLineBenchmarks()
+      : juce::UnitTest("PooledDelayLine", "a0LearnDelay Benchmarks") {}
+
+  void runTest() override {
+    for (int numChannels : {2, 8, 16}) {
+      beginTest(juce::String(numChannels) + " channels");
+      run(numChannels);
+    }
+  }
+
+private:
+  using PlanarDelayLine =
+      juce::dsp::DelayLine<float,
+                           juce::dsp::DelayLineInterpolationTypes::Linear>;
+
+  static constexpr double sampleRate = 48000.0;
+  static constexpr double delayInSeconds = 4.5;
+
+  // Ten seconds, the delay line wraps around twice
+  static constexpr size_t numFrames = 10 * 48000;
+
+  void run(int numChannels) {
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = juce::uint32(numChannels);
+
+    int maxDelayInSamples =
+        int(std::ceil(Parameters::maxDelayTime / 1000.0 * sampleRate));
+
+    // A fraction of a sample so the interpolation is part of the timing
+    float delayInSamples = float(delayInSeconds * sampleRate) + 0.25f;
+
+    PooledDelayLine interleaved;
+    interleaved.prepare(spec);
+    interleaved.setMaximumDelayInSamples(maxDelayInSamples);
+    interleaved.setDelay(delayInSamples);
+
+    PlanarDelayLine planar;
+    planar.prepare(spec);
+    planar.setMaximumDelayInSamples(maxDelayInSamples);
+    planar.setDelay(delayInSamples);
+
+    juce::Random random(1);
+    std::vector<float> input(numFrames);
+    for (auto &sample : input)
+      sample = random.nextFloat() * 2.0f - 1.0f;
+
+    std::vector<float> interleavedOutput(numFrames);
+    std::vector<float> planarOutput(numFrames);
+
+    double interleavedSeconds =
+        process(interleaved, numChannels, input, interleavedOutput);
+    double planarSeconds = process(planar, numChannels, input, planarOutput);
+
+    double numSamples = double(numFrames) * numChannels;
+    logMessage(juce::String::formatted(
+        "%d channels: interleaved %.2f ns, planar %.2f ns per sample, "
+        "%.2fx",
+        numChannels, interleavedSeconds * 1.0e9 / numSamples,
+        planarSeconds * 1.0e9 / numSamples,
+        planarSeconds / interleavedSeconds));
+
+    float maxDifference = 0.0f;
+    for (size_t i = 0; i < interleavedOutput.size(); ++i)
+      maxDifference = std::max(
+          maxDifference, std::abs(interleavedOutput[i] - planarOutput[i]));
+
+    expectEquals(maxDifference, 0.0f, "interleaved versus planar output");
+  }
+
+  // Returns the time taken, output gets the sum of all channels per frame
+  template <typename DelayLine>
+  static double process(DelayLine &delayLine, int numChannels,
+                        const std::vector<float> &input,
+                        std::vector<float> &output) {
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (size_t frame = 0; frame < input.size(); ++frame) {
+      // Every channel a little different, the sum still shows any mix-up
+      for (int channel = 0; channel < numChannels; ++channel)
+        delayLine.pushSample(channel, input[frame] * float(channel + 1));
+
+      float sum = 0.0f;
+      for (int channel = 0; channel < numChannels; ++channel)
+        sum += delayLine.popSample(channel);
+
+      output[frame] = sum;
+    }
+
+    return juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - start);
+  }
+};
+
+static PooledDelayLineBenchmarks pooledDelayLineBenchmarks;
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    StartupBenchmarks.cpp
+    Created: 22 Oct 2026 11:37:06am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "../Source/PluginEditor.h"
+#include "../Source/PluginProcessor.h"
+
+/*
+ Times what a host does when it loads a session: constructing the
+ processors, preparing them and opening editors. The first editor builds
+ the shared EditorResources, the second one is opened while the first is
+ still showing and only adds its own components.
+
+ Timings are only logged, they depend on the machine. What is checked is
+ that both editors are created. Run with a0LearnDelayBatch --benchmark.
+*/
+class StartupBenchmarks : public juce::UnitTest {
+public:
+  StartupBenchmarks()
+      : juce::UnitTest("Startup", "a0LearnDelay Benchmarks") {}
+
+  void runTest() override {
+    std::vector<std::unique_ptr<A0LearnDelayAudioProcessor>> processors;
+    processors.reserve(size_t(numInstances));
+
+    beginTest("Construction");
+    double seconds = time([&] {
+      for (int i = 0; i < numInstances; ++i)
+        processors.push_back(std::make_unique<A0LearnDelayAudioProcessor>());
+    });
+    log("construction", numInstances, seconds);
+
+    beginTest("prepareToPlay");
+    seconds = time([&] {
+      for (int i = 0; i < numPrepared; ++i) {
+        auto &processor = *processors[size_t(i)];
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+      }
+    });
+    log("prepareToPlay", numPrepared, seconds);
+
+    beginTest("Editors");
+    std::unique_ptr<juce::AudioProcessorEditor> first, second;
+
+    seconds = time([&] { first.reset(processors[0]->createEditorIfNeeded()); });
+    log("first editor", 1, seconds);
+
+    seconds =
+        time([&] { second.reset(processors[1]->createEditorIfNeeded()); });
+    log("second editor", 1, seconds);
+
+    expect(first != nullptr && second != nullptr, "editors created");
+
+    // Editors go before their processors
+    second.reset();
+    first.reset();
+
+    for (int i = 0; i < numPrepared; ++i)
+      processors[size_t(i)]->releaseResources();
+  }
+
+private:
+  // A large session
+  static constexpr int numInstances = 300;
+
+  // Each prepared instance takes about 2 MB of delay memory from the
+  // pool, a few dozen show the cost without filling the machine
+  static constexpr int numPrepared = 32;
+
+  static constexpr double sampleRate = 48000.0;
+  static constexpr int blockSize = 512;
+
+  template <typename Function> static double time(Function &&function) {
+    auto start = juce::Time::getHighResolutionTicks();
+    function();
+    return juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - start);
+  }
+
+  void log(const char *what, int count, double seconds) {
+    logMessage(juce::String::formatted(
+        "%s: %.2f ms for %d, %.1f us each", what, seconds * 1.0e3, count,
+        seconds * 1.0e6 / count));
+  }
+};
+
+static StartupBenchmarks startupBenchmarks;
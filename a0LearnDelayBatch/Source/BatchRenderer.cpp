@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 21 Oct 2026 10:04:51am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+#include <iostream>
+#include <map>
+
+// Whole lines from any thread
+static void print(const juce::String &message) {
+  static juce::CriticalSection lock;
+  const juce::ScopedLock scopedLock(lock);
+
+  std::cout << message << std::endl;
+}
+
+// Named after the input without its extension
+static juce::File getOutputFile(const juce::File &outputFolder,
+                                const juce::File &input) {
+  return outputFolder.getChildFile(input.getFileNameWithoutExtension() +
+                                   ".wav");
+}
+
+//==============================================================================
+BatchRenderer::JobQueue::JobQueue(int numWorkers) {
+  for (int i = 0; i < numWorkers; ++i)
+    deques.push_back(std::make_unique<Deque>());
+}
+
+void BatchRenderer::JobQueue::push(int worker, const juce::File &file) {
+  auto &deque = *deques[size_t(worker)];
+  const juce::ScopedLock scopedLock(deque.lock);
+
+  deque.files.push_back(file);
+}
+
+bool BatchRenderer::JobQueue::pop(int worker, juce::File &file) {
+  int numWorkers = int(deques.size());
+
+  // Own files first, newest end
+  {
+    auto &deque = *deques[size_t(worker)];
+    const juce::ScopedLock scopedLock(deque.lock);
+
+    if (!deque.files.empty()) {
+      file = deque.files.back();
+      deque.files.pop_back();
+      return true;
+    }
+  }
+
+  // Then the oldest file of the next worker that still has one
+  for (int i = 1; i < numWorkers; ++i) {
+    auto &deque = *deques[size_t((worker + i) % numWorkers)];
+    const juce::ScopedLock scopedLock(deque.lock);
+
+    if (!deque.files.empty()) {
+      file = deque.files.front();
+      deque.files.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+class BatchRenderer::Worker : public juce::Thread {
+public:
+  Worker(BatchRenderer &newOwner, int newIndex)
+      : juce::Thread("Batch Worker " + juce::String(newIndex)),
+        owner(newOwner), index(newIndex) {
+    formatManager.registerBasicFormats();
+  }
+
+  void run() override {
+    juce::File file;
+
+    while (!threadShouldExit() && owner.queue.pop(index, file)) {
+      if (render(file)) {
+        ++owner.numRendered;
+        print("Rendered " + file.getFileName());
+      } else {
+        ++owner.numFailed;
+        print("Failed " + file.getFileName());
+      }
+    }
+  }
+
+  A0LearnDelayAudioProcessor processor;
+
+private:
+  bool render(const juce::File &input);
+
+  BatchRenderer &owner;
+  int index;
+
+  // Readers are created per worker, the manager is not shared
+  juce::AudioFormatManager formatManager;
+
+  juce::AudioBuffer<float> chunk{2, chunkSize};
+  juce::MidiBuffer midiMessages;
+};
+
+bool BatchRenderer::Worker::render(const juce::File &input) {
+  std::unique_ptr<juce::AudioFormatReader> reader(
+      formatManager.createReaderFor(input));
+  if (reader == nullptr)
+    return false;
+
+  double sampleRate = reader->sampleRate;
+  juce::int64 length = reader->lengthInSamples;
+  juce::int64 total =
+      length + juce::int64(owner.tailInSeconds * sampleRate);
+
+  juce::File output = getOutputFile(owner.settings.outputFolder, input);
+  output.deleteFile();
+
+  auto fileStream = std::make_unique<juce::FileOutputStream>(output);
+  if (fileStream->failedToOpen())
+    return false;
+
+  std::unique_ptr<juce::OutputStream> stream = std::move(fileStream);
+
+  juce::WavAudioFormat wav;
+  auto writer = wav.createWriterFor(
+      stream, juce::AudioFormatWriterOptions{}
+                  .withSampleRate(sampleRate)
+                  .withNumChannels(2)
+                  .withBitsPerSample(owner.settings.bitsPerSample));
+  if (writer == nullptr) {
+    // Still holds the stream, closed before the empty file is deleted
+    stream.reset();
+    output.deleteFile();
+    return false;
+  }
+
+  // Same processor for every file, preparing it resets the running state
+  processor.setNonRealtime(true);
+  processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+  processor.prepareToPlay(sampleRate, blockSize);
+
+  {
+    // Holds a few chunks, the worker only waits when the disk falls behind.
+    // Going out of scope flushes it and finishes the file.
+    juce::AudioFormatWriter::ThreadedWriter threadedWriter(
+        writer.release(), owner.writerThread, 4 * chunkSize);
+
+    for (juce::int64 position = 0; position < total; position += chunkSize) {
+      int numSamples =
+          int(juce::jmin(juce::int64(chunkSize), total - position));
+
+      // Past the end of the input only the tail is rendered
+      chunk.clear();
+      if (position < length) {
+        juce::int64 remaining = length - position;
+        int numToRead = int(juce::jmin(juce::int64(numSamples), remaining));
+        reader->read(&chunk, 0, numToRead, position, true, true);
+      }
+
+      for (int start = 0; start < numSamples; start += blockSize) {
+        int numBlockSamples = juce::jmin(blockSize, numSamples - start);
+        juce::AudioBuffer<float> block(chunk.getArrayOfWritePointers(), 2,
+                                       start, numBlockSamples);
+        processor.processBlock(block, midiMessages);
+      }
+
+      const float *const *channels = chunk.getArrayOfReadPointers();
+      while (!threadedWriter.write(channels, numSamples))
+        juce::Thread::sleep(1);
+    }
+  }
+
+  processor.releaseResources();
+
+  // The writer thread does not report errors, what actually made it to
+  // disk is read back. The header only counts the frames that were written.
+  std::unique_ptr<juce::AudioFormatReader> written(
+      formatManager.createReaderFor(output));
+
+  if (written == nullptr || written->numChannels != 2 ||
+      written->lengthInSamples != total) {
+    written.reset();
+    output.deleteFile();
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+BatchRenderer::BatchRenderer(const Settings &settings)
+    : settings(settings), queue(juce::jmax(1, settings.numThreads)) {}
+
+BatchRenderer::~BatchRenderer() { writerThread.stopThread(10000); }
+
+juce::Result
+BatchRenderer::applyPreset(A0LearnDelayAudioProcessor &processor) const {
+  auto &apvts = processor.apvts;
+
+  if (settings.preset != juce::File()) {
+    auto xml = juce::XmlDocument::parse(settings.preset);
+    if (xml == nullptr || !xml->hasTagName(apvts.state.getType()))
+      return juce::Result::fail("Not a preset: " +
+                                settings.preset.getFullPathName());
+
+    apvts.replaceState(juce::ValueTree::fromXml(*xml));
+  }
+
+  for (auto &id : settings.parameters.getAllKeys()) {
+    auto *parameter = apvts.getParameter(id);
+    if (parameter == nullptr)
+      return juce::Result::fail("Unknown parameter: " + id);
+
+    // Numbers are in the parameter's units, anything else is parsed like
+    // text typed into the plug-in, e.g. a choice name or "On"
+    juce::String text = settings.parameters[id];
+    float value = text.containsOnly("0123456789.-")
+                      ? parameter->convertTo0to1(text.getFloatValue())
+                      : parameter->getValueForText(text);
+
+    parameter->setValueNotifyingHost(value);
+  }
+
+  return juce::Result::ok();
+}
+
+juce::Result BatchRenderer::run() {
+  auto bitDepths = juce::WavAudioFormat().getPossibleBitDepths();
+  if (!bitDepths.contains(settings.bitsPerSample)) {
+    juce::StringArray names;
+    for (int bits : bitDepths)
+      names.add(juce::String(bits));
+
+    return juce::Result::fail("WAV files cannot have " +
+                              juce::String(settings.bitsPerSample) +
+                              " bits, use one of " +
+                              names.joinIntoString(", "));
+  }
+
+  juce::AudioFormatManager formatManager;
+  formatManager.registerBasicFormats();
+
+  auto files = settings.inputFolder.findChildFiles(
+      juce::File::findFiles, false, formatManager.getWildcardForAllFormats());
+  files.sort();
+
+  if (files.isEmpty())
+    return juce::Result::fail("No audio files in " +
+                              settings.inputFolder.getFullPathName());
+
+  if (settings.outputFolder == settings.inputFolder)
+    return juce::Result::fail(
+        "The output folder must not be the input folder");
+
+  // Two inputs that only differ in extension would be written to the same
+  // output by two workers at once. Compared ignoring case, like most
+  // desktop file systems do.
+  std::map<juce::String, juce::File> outputs;
+
+  for (auto &file : files) {
+    auto name = getOutputFile(settings.outputFolder, file).getFileName();
+    auto [existing, added] = outputs.emplace(name.toLowerCase(), file);
+
+    if (!added)
+      return juce::Result::fail(existing->second.getFileName() + " and " +
+                                file.getFileName() +
+                                " would both be rendered to " + name);
+  }
+
+  auto created = settings.outputFolder.createDirectory();
+  if (created.failed())
+    return created;
+
+  int numWorkers = juce::jlimit(1, files.size(), settings.numThreads);
+
+  for (int i = 0; i < files.size(); ++i)
+    queue.push(i % numWorkers, files[i]);
+
+  // Processors are created and set up here, every worker thread then only
+  // ever touches its own
+  juce::OwnedArray<Worker> workers;
+
+  for (int i = 0; i < numWorkers; ++i) {
+    auto *worker = workers.add(new Worker(*this, i));
+
+    auto result = applyPreset(worker->processor);
+    if (result.failed())
+      return result;
+  }
+
+  // Every worker has the same preset, the first one's tail is everyone's
+  tailInSeconds = settings.tailInSeconds.value_or(
+      workers[0]->processor.getTailLengthSeconds());
+
+  if (std::isinf(tailInSeconds))
+    return juce::Result::fail(
+        "Freeze is on, the tail never ends. Give its length with --tail.");
+
+  print("Rendering " + juce::String(files.size()) + " files on " +
+        juce::String(numWorkers) + " threads");
+
+  writerThread.startThread();
+
+  for (auto *worker : workers)
+    worker->startThread();
+
+  for (auto *worker : workers)
+    worker->waitForThreadToExit(-1);
+
+  print("Rendered " + juce::String(numRendered.load()) + ", failed " +
+        juce::String(numFailed.load()));
+
+  if (numFailed > 0)
+    return juce::Result::fail(juce::String(numFailed.load()) + " of " +
+                              juce::String(files.size()) +
+                              " files could not be rendered");
+
+  return juce::Result::ok();
+}
+
+void BatchRenderer::printParameters() {
+  A0LearnDelayAudioProcessor processor;
+
+  for (auto *parameter : processor.getParameters()) {
+    auto *ranged = dynamic_cast<juce::RangedAudioParameter *>(parameter);
+    if (ranged == nullptr)
+      continue;
+
+    float defaultValue = ranged->getDefaultValue();
+    juce::String values;
+
+    if (auto *choice = dynamic_cast<juce::AudioParameterChoice *>(ranged)) {
+      values = choice->choices.joinIntoString(" | ");
+    } else {
+      auto &range = ranged->getNormalisableRange();
+      values = juce::String(range.start) + " .. " + juce::String(range.end);
+    }
+
+    print(ranged->getParameterID() + " (" + ranged->getName(64) + ") : " +
+          values + ", default " + ranged->getText(defaultValue, 64));
+  }
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 21 Oct 2026 10:04:51am
+    Author:  Sumedhan Ramesh
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../a0LearnDelay/Source/PluginProcessor.h"
+#include <JuceHeader.h>
+#include <deque>
+#include <optional>
+
+/*
+ Offline rendering of every audio file in a folder through the delay with
+ one preset.
+
+ Every worker thread owns one processor and pulls files from a
+ work-stealing queue. Files are dealt round-robin to the workers up
+ front; a worker takes from its own end of its queue and, once that is
+ empty, steals from the other end of the others, so a few long files do
+ not leave the rest of the machine idle.
+
+ Input is decoded in chunks of chunkSize frames, processed in blocks of
+ blockSize and handed to a ThreadedWriter, whose one shared writer
+ thread encodes and writes the output while the workers keep rendering.
+
+ Output is stereo WAV at the input sample rate, named after the input,
+ mono input is played on both channels. The delay tail is rendered past
+ the end of the input, by default for as long as the processor reports
+ after the preset is applied. Every output is read back once it is
+ finished, a short or unreadable file counts as failed and is deleted.
+*/
+class BatchRenderer {
+public:
+  struct Settings {
+    juce::File inputFolder;
+    juce::File outputFolder;
+
+    // Plug-in state as saved by getStateInformation, as XML
+    juce::File preset;
+
+    // Parameter ID to value in the parameter's own units, applied after
+    // the preset
+    juce::StringPairArray parameters;
+
+    int numThreads = juce::SystemStats::getNumCpus();
+
+    // Unset, the tail is getTailLengthSeconds of the preset
+    std::optional<double> tailInSeconds;
+
+    // One of WavAudioFormat::getPossibleBitDepths
+    int bitsPerSample = 24;
+  };
+
+  explicit BatchRenderer(const Settings &settings);
+  ~BatchRenderer();
+
+  // Renders all files, fails if the preset, a parameter or the bit depth is
+  // invalid, if the preset's tail never ends and no tail was given, if two
+  // inputs would be rendered to the same output or if any file could not
+  // be rendered
+  juce::Result run();
+
+  // Prints the parameters of createParameterLayout with their ranges
+  static void printParameters();
+
+  static constexpr int chunkSize = 1 << 16;
+  static constexpr int blockSize = 512;
+
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderer)
+
+  /*
+   One deque of files per worker. The owner pops from the back, thieves
+   steal from the front. Files are only added before the workers start,
+   so an empty queue everywhere means the batch is done.
+  */
+  class JobQueue {
+  public:
+    explicit JobQueue(int numWorkers);
+
+    void push(int worker, const juce::File &file);
+    bool pop(int worker, juce::File &file);
+
+  private:
+    struct Deque {
+      juce::CriticalSection lock;
+      std::deque<juce::File> files;
+    };
+
+    std::vector<std::unique_ptr<Deque>> deques;
+  };
+
+  class Worker;
+
+  juce::Result applyPreset(A0LearnDelayAudioProcessor &processor) const;
+
+  Settings settings;
+
+  // settings.tailInSeconds, or the preset's tail when that is unset
+  double tailInSeconds = 0.0;
+
+  JobQueue queue;
+  juce::TimeSliceThread writerThread{"Batch Writer"};
+
+  std::atomic<int> numRendered{0};
+  std::atomic<int> numFailed{0};
+};
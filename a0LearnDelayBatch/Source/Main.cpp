@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+#include <JuceHeader.h>
+
+static void render(const juce::ArgumentList &args) {
+  BatchRenderer::Settings settings;
+
+  settings.inputFolder = args.getExistingFolderForOption("--input");
+
+  args.failIfOptionIsMissing("--output");
+  settings.outputFolder = args.getFileForOption("--output");
+
+  if (args.containsOption("--preset"))
+    settings.preset = args.getExistingFileForOption("--preset");
+
+  if (args.containsOption("--threads"))
+    settings.numThreads = args.getValueForOption("--threads").getIntValue();
+
+  if (args.containsOption("--tail"))
+    settings.tailInSeconds =
+        args.getValueForOption("--tail").getDoubleValue();
+
+  if (args.containsOption("--bits"))
+    settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+
+  // --set=id=value, any number of times
+  for (int i = 0; i < args.size(); ++i) {
+    juce::String text = args[i].text;
+
+    if (text.startsWith("--set=")) {
+      juce::String assignment = text.fromFirstOccurrenceOf("=", false, false);
+      settings.parameters.set(
+          assignment.upToFirstOccurrenceOf("=", false, false),
+          assignment.fromFirstOccurrenceOf("=", false, false));
+    }
+  }
+
+  BatchRenderer renderer(settings);
+
+  auto result = renderer.run();
+  if (result.failed())
+    juce::ConsoleApplication::fail(result.getErrorMessage());
+}
+
+static void runTests(const juce::String &category) {
+  juce::UnitTestRunner runner;
+  runner.setAssertOnFailure(false);
+  runner.runTestsInCategory(category);
+
+  for (int i = 0; i < runner.getNumResults(); ++i)
+    if (runner.getResult(i)->failures > 0)
+      juce::ConsoleApplication::fail(category + " failed");
+}
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  // The processors' parameter trees start timers, which need a message
+  // manager even though no message loop runs
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  juce::ConsoleApplication app;
+
+  app.addHelpCommand("--help|-h", "a0LearnDelay batch renderer", true);
+
+  app.addCommand({"--list", "--list",
+                  "Lists the parameter IDs, ranges and defaults", "",
+                  [](const juce::ArgumentList &) {
+                    BatchRenderer::printParameters();
+                  }});
+
+  app.addCommand({"--test", "--test",
+                  "Runs the unit tests of the plug-in code", "",
+                  [](const juce::ArgumentList &) {
+                    runTests("a0LearnDelay");
+                  }});
+
+  app.addCommand({"--benchmark", "--benchmark",
+                  "Times the plug-in code and logs the results", "",
+                  [](const juce::ArgumentList &) {
+                    runTests("a0LearnDelay Benchmarks");
+                  }});
+
+  app.addDefaultCommand(
+      {"",
+       "--input=<folder> --output=<folder> [--preset=<file>] "
+       "[--set=<id>=<value> ...] [--threads=<n>] [--tail=<seconds>] "
+       "[--bits=<n>]",
+       "Renders every audio file in a folder through the delay",
+       "The preset is a plug-in state saved as XML. --set overrides single "
+       "parameters, in their own units or as their display text, see "
+       "--list. Output files are stereo WAV with the input's name. "
+       "Without --tail, the tail is as long as the preset's delay rings.",
+       render});
+
+  return app.findAndRunCommand(argc, argv);
+}